@@ -0,0 +1,287 @@
+/**
+ *  @mainpage Latin Square
+ *  @file estimate.c
+ *  @brief Source file for the search tree size estimator of the Latin Square.
+ *
+ *  This program estimates the size of the search tree of a Latin Square with Knuth's
+ *  random probes. Each probe goes down the tree like the solver does, from the cell it
+ *  selects to the next, but it inserts one random valid number in each cell instead
+ *  of trying them all, and the product of the numbers of choices on its path estimates
+ *  the number of nodes at each depth. The mean of the probes is an unbiased estimate of
+ *  the size of the tree, and the time of a step is measured by running the solver that
+ *  would do the search for a small number of steps.
+ *
+ *  @author Christos Michael (ID: 1135102 / UC1070456)
+ *          Leandros Antoniades (ID: 1119296 / UC1069738)
+ *
+ *  @bug No known bugs.
+ *
+ */
+#include<stdio.h>
+#include<stdlib.h>
+#include<math.h>
+#include<time.h>
+#include"estimate.h"
+#include"kernels.h"
+
+/**
+ *  @brief Returns the next random number of a sequence (splitmix64).
+ *
+ *  @param state Pointer to the state of the sequence.
+ *
+ *  @return Returns the random number.
+ *
+ */
+static unsigned long long nextRandom(unsigned long long *state){
+
+    unsigned long long x = (*state += 0x9E3779B97F4A7C15ULL);
+
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+
+    return x ^ (x >> 31);
+
+}
+
+/**
+ *  @brief Runs one random probe down the search tree.
+ *
+ *  The probe starts from the clues and at each depth it counts the valid numbers of the cell the
+ *  solver would select, which are the children of the node, and inserts one of them at random. With propagation at
+ *  every node the numbers the propagation ruled out are not children, like in the solver, and the probe
+ *  stops at a node the propagation finds unsolvable, since the solver backtracks from it.
+ *
+ *  @param board 2D array for the Latin Square of the probe.
+ *  @param square 2D array representing the starting Latin Square.
+ *  @param size The size of the square array.
+ *  @param cells The cell selection of the solver.
+ *  @param used Array of marks for findFewestCell().
+ *  @param prop A pointer to the propagator after propagate() on the Latin Square, NULL if the nodes are not propagated.
+ *  @param values Array for the valid numbers of a cell.
+ *  @param state Pointer to the state of the random numbers.
+ *  @param solved Pointer to a boolean that is set if the probe filled every cell.
+ *
+ *  @return Returns the estimated number of nodes of the tree, without the root.
+ *
+ */
+static double probeTree(int **board, int **square, int size, CELL_SELECTION cells, char *used, PROPAGATOR *prop, int *values, unsigned long long *state, bool *solved){
+
+    double weight = 1; //  Product of the numbers of children on the path, the estimated number of nodes at the depth.
+    double total = 0;
+    int row, col;
+    bool empty; //  True if the Latin Square of the probe has an empty cell.
+
+    *solved = false;
+
+    for(int i=0; i<size; i++){
+
+        for(int j=0; j<size; j++) board[i][j] = square[i][j];
+
+    }
+
+    while(true){
+
+        if(cells == CELLS_FEWEST) empty = findFewestCell(board,size,used,&row,&col);
+        else empty = findEmptyCell(board,size,&row,&col);
+
+        if(empty == false){ //  The probe filled every cell.
+
+            *solved = true;
+            break;
+
+        }
+
+        int count = 0; //  Number of valid numbers of the cell.
+        char *domain = (prop != NULL) ? prop->domain + (row*size + col)*(size + 1) : NULL; //  Numbers of the cell that the propagation did not rule out.
+
+        for(int v=1; v<=size; v++){
+
+            bool found = true;
+
+            if(domain != NULL && domain[v] == 0) continue; //  The solver skips the numbers the propagation ruled out.
+
+            for(int j=0; j<size; j++){
+
+                if(abs(board[j][col]) == v || abs(board[row][j]) == v){
+
+                    found = false;
+                    break;
+
+                }
+
+            }
+
+            if(found == true) values[count++] = v;
+
+        }
+
+        if(count == 0) break; //  A dead end, the solver backtracks from here.
+
+        weight *= count;
+        total += weight;
+        board[row][col] = values[nextRandom(state) % count];
+
+        if(prop != NULL && assignCell(prop,row,col,board[row][col]) == false) break;
+
+    }
+
+    while(prop != NULL && prop->levels > 0) undoAssign(prop); //  Restores the domains of the starting Latin Square for the next probe.
+
+    return total;
+
+}
+
+/**
+ *  @brief Times a number of steps of the solver that would do the search.
+ *
+ *  The search is quiet and without trace, and it is done by the kernel for the size if the
+ *  configuration allows it, like solveLatinSquare() does. If it finishes within the steps
+ *  the estimate is exact.
+ *
+ *  @param square 2D array representing the Latin Square.
+ *  @param size The size of the square array.
+ *  @param config Pointer to the configuration of the solver.
+ *  @param estimate Pointer to the estimate.
+ *
+ *  @return Returns void.
+ *
+ */
+static void calibrate(int **square, int size, const SOLVER_CONFIG *config, ESTIMATE *estimate){
+
+    SOLVER_CONFIG quiet = *config;
+    SOLVER *solver;
+    clock_t start;
+    int steps;
+
+    quiet.verbose = false;
+    quiet.traceFile = NULL;
+    solver = initSolver(square,size,&quiet);
+    start = clock();
+
+    if(useKernel(&quiet,size) == true){
+
+        if(propagateClues(solver) == true) solver->status = solveWithKernel(solver->square,size,KERNEL_CALIBRATION_STEPS,&solver->pushCount,&solver->popCount);
+
+        steps = solver->pushCount + solver->popCount;
+
+    }
+    else{
+
+        runSolver(solver,GENERIC_CALIBRATION_STEPS);
+        steps = solver->steps;
+
+    }
+
+    double seconds = (double)(clock() - start)/CLOCKS_PER_SEC;
+
+    estimate->calibrationSteps = steps;
+    estimate->secondsPerStep = (steps > 0) ? seconds/steps : 0;
+    estimate->status = solver->status;
+    estimate->exact = (solver->status != SOLVER_RUNNING);
+    estimate->nodesLow = solver->pushCount; //  The nodes that were already pushed are a lower bound.
+
+    if(estimate->exact == true){
+
+        estimate->nodes = estimate->nodesHigh = solver->pushCount;
+        estimate->seconds = estimate->secondsLow = estimate->secondsHigh = seconds;
+
+    }
+
+    freeSolver(solver);
+
+}
+
+/**
+ *  @brief Estimates the number of nodes and the time of the search of a Latin Square.
+ *
+ *  First a few steps of the search are timed, and if the search did not finish the size of the
+ *  tree is estimated with random probes. The estimate is for the whole tree, and the search stops at
+ *  the first solution, so for a solvable Latin Square it is an upper bound that can be orders of
+ *  magnitude too large, even if no probe solved it. A search of n nodes takes about 2n + 1 steps, a push and
+ *  a pop for each node and the last step that finds the root has no numbers left. The interval
+ *  is the normal approximation of the mean of the probes, which is wide for trees whose size
+ *  depends on a few rare paths.
+ *
+ *  @param square 2D array representing the Latin Square.
+ *  @param size The size of the square array.
+ *  @param config Pointer to the configuration of the solver, the restarts are not estimated.
+ *  @param probes Number of random probes.
+ *  @param estimate Pointer to the estimate that is filled.
+ *
+ *  @return Returns void.
+ *
+ */
+void estimateSearch(int **square, int size, const SOLVER_CONFIG *config, int probes, ESTIMATE *estimate){
+
+    estimate->probes = 0;
+    estimate->solvedProbes = 0;
+    calibrate(square,size,config,estimate);
+
+    if(estimate->exact == true) return;
+
+    PROPAGATOR *prop = (config->propagation == PROPAGATION_NODES) ? initPropagator(size) : NULL;
+
+    unsigned long long state = config->seed;
+    int **board = (int **)malloc(size*sizeof(int *));
+    int *values = (int *)malloc(size*sizeof(int));
+    char *used = (char *)malloc(2*size*(size + 1));
+    double mean = 0;
+    double squares = 0; //  Sum of the squared differences from the mean (Welford's method).
+
+    if(board == NULL || values == NULL || used == NULL){
+
+        printf("Error: Failed to allocate memory for the estimate.\n");
+        exit(-1);
+
+    }
+
+    for(int i=0; i<size; i++){
+
+        board[i] = (int *)malloc(size*sizeof(int));
+
+        if(board[i] == NULL){
+
+            printf("Error: Failed to allocate memory for the estimate.\n");
+            exit(-1);
+
+        }
+
+    }
+
+    if(prop != NULL) propagate(prop,square); //  The timed search already found the clues consistent.
+
+    for(int k=1; k<=probes; k++){
+
+        bool solved;
+        double nodes = probeTree(board,square,size,config->cells,used,prop,values,&state,&solved);
+        double delta = nodes - mean;
+
+        mean += delta/k;
+        squares += delta*(nodes - mean);
+        if(solved == true) estimate->solvedProbes++;
+
+    }
+
+    double error = (probes > 1) ? 1.96*sqrt(squares/(probes - 1)/probes) : 0; //  Half width of the 95% interval.
+
+    estimate->probes = probes;
+    estimate->nodes = mean;
+    estimate->nodesHigh = mean + error;
+
+    //  The nodes that were already pushed are a lower bound of the estimate and of its interval.
+    if(mean - error > estimate->nodesLow) estimate->nodesLow = mean - error;
+    if(estimate->nodes < estimate->nodesLow) estimate->nodes = estimate->nodesLow;
+    if(estimate->nodesHigh < estimate->nodesLow) estimate->nodesHigh = estimate->nodesLow;
+
+    estimate->seconds = (2*estimate->nodes + 1)*estimate->secondsPerStep;
+    estimate->secondsLow = (2*estimate->nodesLow + 1)*estimate->secondsPerStep;
+    estimate->secondsHigh = (2*estimate->nodesHigh + 1)*estimate->secondsPerStep;
+
+    //  Frees the allocated memory.
+    for(int i=0; i<size; i++) free(board[i]);
+    free(board);
+    free(values);
+    free(used);
+    freePropagator(prop);
+
+}
@@ -0,0 +1,53 @@
+/**
+ *  @mainpage Latin Square
+ *  @file estimate.h
+ *  @brief Header file for the search tree size estimator of the Latin Square.
+ *
+ *  This program contains the estimate data structure and the function declarations
+ *  for estimating the number of nodes and the time of a search before running it.
+ *
+ *  @author Christos Michael (ID: 1135102 / UC1070456)
+ *          Leandros Antoniades (ID: 1119296 / UC1069738)
+ *
+ *  @bug No known bugs.
+ *
+ */
+#ifndef ESTIMATE_H
+#define ESTIMATE_H
+
+#include<stdbool.h>
+#include"solver.h"
+
+#define DEFAULT_PROBES 1000 //  Random probes of an estimate, unless the command line sets them.
+#define GENERIC_CALIBRATION_STEPS 20000 //  Steps of the generic solver that are timed.
+#define KERNEL_CALIBRATION_STEPS 200000 //  Steps of a kernel that are timed.
+
+/**
+ *  @brief Represents the estimated size and time of a search.
+ *
+ *  The nodes are the pushes of a search that explores the whole tree, so for a solvable Latin
+ *  Square they are an upper bound of the pushes until the first solution. The intervals are
+ *  95% confidence intervals of the mean of the probes.
+ *
+ */
+typedef struct{
+
+    double nodes; //  Estimated number of nodes of the search tree, without the root.
+    double nodesLow;
+    double nodesHigh;
+    double secondsPerStep; //  Measured time of a step of the solver that would do the search.
+    double seconds; //  Estimated time of the search.
+    double secondsLow;
+    double secondsHigh;
+    int probes; //  Number of random probes.
+    int solvedProbes; //  Number of probes that solved the Latin Square.
+    int calibrationSteps; //  Number of steps that were timed.
+    bool exact; //  True if the search finished while it was timed, so the nodes and the time are exact.
+    SOLVER_STATUS status; //  Result of the search if it is exact, else SOLVER_RUNNING.
+
+}ESTIMATE;
+
+//  Estimate function declarations.
+void estimateSearch(int **square, int size, const SOLVER_CONFIG *config, int probes, ESTIMATE *estimate);
+
+#endif
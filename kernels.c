@@ -0,0 +1,146 @@
+/**
+ *  @mainpage Latin Square
+ *  @file kernels.c
+ *  @brief Source file for the solver kernels that are specialized for one order.
+ *
+ *  This program generates a solver kernel for each common order of the Latin Square
+ *  from the template in kernel.inc, and picks the kernel for the order of a Latin Square.
+ *  The other orders are solved by the generic solver.
+ *
+ *  @author Christos Michael (ID: 1135102 / UC1070456)
+ *          Leandros Antoniades (ID: 1119296 / UC1069738)
+ *
+ *  @bug No known bugs.
+ *
+ */
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include"kernels.h"
+
+#define KERNEL_JOIN(name, order) name##order
+#define KERNEL_NAME(order) KERNEL_JOIN(solveKernel, order) //  Name of the kernel of an order, e.g. solveKernel9.
+
+/**
+ *  @brief Finds the lowest set bit of a mask.
+ *
+ *  @param mask The mask, it must not be 0.
+ *
+ *  @return Returns the index of the lowest set bit.
+ *
+ */
+static inline int lowestBit(unsigned int mask){
+
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+
+    while((mask & 1u) == 0){
+
+        mask >>= 1;
+        bit++;
+
+    }
+
+    return bit;
+#endif
+
+}
+
+//  Generates the kernels.
+#define KERNEL_ORDER 4
+#define KERNEL_MASK uint8_t
+#include"kernel.inc"
+
+#define KERNEL_ORDER 5
+#define KERNEL_MASK uint8_t
+#include"kernel.inc"
+
+#define KERNEL_ORDER 6
+#define KERNEL_MASK uint8_t
+#include"kernel.inc"
+
+#define KERNEL_ORDER 7
+#define KERNEL_MASK uint8_t
+#include"kernel.inc"
+
+#define KERNEL_ORDER 8
+#define KERNEL_MASK uint8_t
+#include"kernel.inc"
+
+#define KERNEL_ORDER 9
+#define KERNEL_MASK uint16_t
+#include"kernel.inc"
+
+#define KERNEL_ORDER 16
+#define KERNEL_MASK uint16_t
+#include"kernel.inc"
+
+/**
+ *  @brief Checks if there is a kernel for an order.
+ *
+ *  @param size The order of the Latin Square.
+ *
+ *  @return Returns true if there is a kernel for the order, else it returns false.
+ *
+ */
+bool hasKernel(int size){
+
+    return (size >= 4 && size <= 9) || size == 16;
+
+}
+
+/**
+ *  @brief Checks if a search with a configuration is done by the kernel for an order.
+ *
+ *  The kernels only do the quiet ascending search of the first empty cells without restarts, propagation at every
+ *  node or trace, so any other configuration is done by the generic solver.
+ *
+ *  @param config Pointer to the configuration of the solver.
+ *  @param size The order of the Latin Square.
+ *
+ *  @return Returns true if the kernel does the search, else it returns false.
+ *
+ */
+bool useKernel(const SOLVER_CONFIG *config, int size){
+
+    return config->kernels == true && config->verbose == false && config->cells == CELLS_FIRST_EMPTY && config->order == ORDER_ASCENDING && config->restart == RESTART_NONE &&
+           config->propagation != PROPAGATION_NODES && config->traceFile == NULL && hasKernel(size) == true;
+
+}
+
+/**
+ *  @brief Solves a Latin Square with the kernel for its order.
+ *
+ *  The kernel does the same search as the generic solver with the ascending order, without
+ *  displaying the steps. If the Latin Square is solved its empty cells are filled.
+ *
+ *  @param square 2D array representing the Latin Square.
+ *  @param size The size of the square array, hasKernel(size) must be true.
+ *  @param maxSteps The number of steps after which the search stops, 0 for no limit.
+ *  @param pushCount Pointer to the counter of the pushes.
+ *  @param popCount Pointer to the counter of the pops.
+ *
+ *  @return Returns the status of the search, SOLVER_RUNNING if it stopped after maxSteps.
+ *
+ */
+SOLVER_STATUS solveWithKernel(int **square, int size, int maxSteps, int *pushCount, int *popCount){
+
+    switch(size){
+
+        case 4: return solveKernel4(square, maxSteps, pushCount, popCount);
+        case 5: return solveKernel5(square, maxSteps, pushCount, popCount);
+        case 6: return solveKernel6(square, maxSteps, pushCount, popCount);
+        case 7: return solveKernel7(square, maxSteps, pushCount, popCount);
+        case 8: return solveKernel8(square, maxSteps, pushCount, popCount);
+        case 9: return solveKernel9(square, maxSteps, pushCount, popCount);
+        case 16: return solveKernel16(square, maxSteps, pushCount, popCount);
+        default:
+
+            printf("Error: There is no kernel for size %d.\n", size);
+            exit(-1);
+
+    }
+
+}
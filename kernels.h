@@ -0,0 +1,26 @@
+/**
+ *  @mainpage Latin Square
+ *  @file kernels.h
+ *  @brief Header file for the solver kernels that are specialized for one order.
+ *
+ *  This program contains the function declarations for picking and running a solver
+ *  kernel that was generated at compile time for the order of the Latin Square.
+ *
+ *  @author Christos Michael (ID: 1135102 / UC1070456)
+ *          Leandros Antoniades (ID: 1119296 / UC1069738)
+ *
+ *  @bug No known bugs.
+ *
+ */
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include<stdbool.h>
+#include"solver.h"
+
+//  Kernel function declarations.
+bool hasKernel(int size);
+bool useKernel(const SOLVER_CONFIG *config, int size);
+SOLVER_STATUS solveWithKernel(int **square, int size, int maxSteps, int *pushCount, int *popCount);
+
+#endif
@@ -15,16 +15,24 @@
 #include<stdio.h>
 #include<stdlib.h>
 #include<stdbool.h>
-#include"stack.h"
+#include<string.h>
+#include"solver.h"
+#include"kernels.h"
+#include"estimate.h"
+#include"portfolio.h"
 
 #define N 9 //  Max Latin Square the program can handle.(else if N > 9 the displayLatinSquare does not work properly)
 
 //  Function declarations.
 bool readLatinSquare(FILE *infile, int size, int **square);
-bool isSolved(int **square, int size);
-void displayLatinSquare(int size, int **square);
-bool findEmptyCell(int **square, int size, int *row, int *col);
-void solveLatinSquare(int **square, int size);
+void solveLatinSquare(int **square, int size, const SOLVER_CONFIG *config);
+int readClueEdits(FILE *editsFile, int size, CLUE_EDIT *edits);
+void resolveWithEdits(int **square, int size, FILE *editsFile, const SOLVER_CONFIG *config);
+void printResult(SOLVER *solver);
+void printEstimate(int **square, int size, const SOLVER_CONFIG *config, int probes);
+void solvePortfolio(int **square, int size, const SOLVER_CONFIG *config, int threads, const char *statsName);
+void printUsage();
+char *optionValue(int argc, char *argv[], int *i);
 
 /**
 *  @brief Reads the Latin Square from a file and checks if the starting
@@ -125,255 +133,349 @@ bool readLatinSquare(FILE *infile, int size, int **square){
 
 }
 
-/** 
- *  @brief Checks if the Latin Square is solved.
+/**
+ *  @brief Solves the Latin Square using a backtracking algorithm.
  * 
- *  This function checks if the Latin Square is solved by checking if there are any empty squares.
- *  Assuming that only valid values were inserted in the Latin Square.
+ *  This function solves a Latin Square with the backtracking solver, displaying every step of the
+ *  search unless the configuration is quiet, and displays the total number of pushes and pops at the end.
+ *  A quiet search in ascending order is done by the kernel specialized for the size, if there is one.
  * 
  *  @param square 2D array representing the Latin Square.
  *  @param size The size of the square array.
+ *  @param config Pointer to the configuration of the solver.
  * 
- *  @return Returns true if the Latin Square is solved, else it returns false.
+ *  @return Returns void.
  * 
  */
-bool isSolved(int **square, int size){
+void solveLatinSquare(int **square, int size, const SOLVER_CONFIG *config){
 
-   int count = 0; 
-   
-   //  Assuming that only valid Latin Square are read from the file if there are no emtpy cells that means that the Latin Square is solved
-   for(int i=0; i<size; i++){
+   SOLVER *solver = initSolver(square,size,config);
 
-       for(int j=0; j<size; j++){
+   //  A quiet ascending search without restarts, propagation at every node or trace is done by the kernel for the size, if there is one.
+   if(useKernel(config,size) == true){
 
-           if(square[i][j] == 0){
+       if(propagateClues(solver) == true) solver->status = solveWithKernel(solver->square,size,0,&solver->pushCount,&solver->popCount);
 
-               count++;                
-               
-           }
+   }
+   else{
 
-       }
+       runSolver(solver,0);
 
    }
 
-   if(count == 0){
+   printResult(solver);
 
-       return true;
+   freeSolver(solver); //  Frees the allocated memory for the solver.
 
-   }
-   else{
+}
+
+/**
+ *  @brief Displays the result of a solver.
+ * 
+ *  If the solver is quiet the solved Latin Square or the unsolvable message is displayed, since the
+ *  steps were not. Then the total number of pushes and pops (and restarts and prunes) are displayed.
+ * 
+ *  @param solver A pointer to the solver.
+ * 
+ *  @return Returns void.
+ * 
+ */
+void printResult(SOLVER *solver){
 
-       return false;
+   if(solver->config.verbose == false){
+
+       if(solver->status == SOLVER_SOLVED) displayLatinSquare(solver->size,solver->square);
+       else if(solver->status == SOLVER_UNSOLVABLE) printf("THE LATIN SQUARE IS UNSOLVABLE!!\n");
 
    }
 
+   printf("PUSH NUM: %d\n", solver->pushCount);
+   printf("POP NUM: %d\n", solver->popCount);
+
+   if(solver->config.restart != RESTART_NONE) printf("RESTARTS: %d\n", solver->restarts);
+   if(solver->config.propagation == PROPAGATION_NODES) printf("PRUNE NUM: %d\n", solver->pruneCount);
+
 }
 
 /**
-*  @brief Displays the Latin Square on the screen.
-* 
-*  This function displays the Latin Square on the screen within a border.
-*  
-*  @param size The size of the Latin Square.
-*  @param square 2D array representing the Latin Square.
-* 
-*  @return Void.
-*  
-*/
-void displayLatinSquare(int size, int **square){
+ *  @brief Estimates and displays the number of nodes and the time of the search of a Latin Square.
+ * 
+ *  The Latin Square is not solved, unless its search finishes while the steps of the solver are timed.
+ *  Every line has a fixed label, so the estimates of many Latin Squares can be compared by a script.
+ *  The probes estimate the whole search tree, so the lines of a search that did not finish are
+ *  labelled as the full tree, which is only an upper bound of a search that finds a solution.
+ * 
+ *  @param square 2D array representing the Latin Square.
+ *  @param size The size of the square array.
+ *  @param config Pointer to the configuration of the solver.
+ *  @param probes Number of random probes.
+ * 
+ *  @return Returns void.
+ * 
+ */
+void printEstimate(int **square, int size, const SOLVER_CONFIG *config, int probes){
 
-   for(int i=0; i<size; i++){
+   ESTIMATE estimate;
 
-       //  Prints the lines of the square
-       for(int j=0; j<size; j++){
+   estimateSearch(square,size,config,probes,&estimate);
 
-           printf("+-----");
+   if(estimate.exact == true){
 
-       }
+       printf("THE SEARCH FINISHED WHILE IT WAS TIMED, THE LATIN SQUARE IS %s\n", (estimate.status == SOLVER_SOLVED) ? "SOLVABLE" : "UNSOLVABLE");
 
-       printf("+");
-       printf("\n");
+   }
 
-       for(int j=0; j<size; j++){
+   printf("PROBES: %d (%d SOLVED THE LATIN SQUARE)\n", estimate.probes, estimate.solvedProbes);
 
-           if(square[i][j] < 0){
+   if(estimate.exact == true){
 
-               printf("| (%d) ", abs(square[i][j]));
+       printf("ESTIMATED NODES: %.4g (95%% CI %.4g - %.4g)\n", estimate.nodes, estimate.nodesLow, estimate.nodesHigh);
+       printf("SECONDS PER STEP: %.4g (%d STEPS TIMED)\n", estimate.secondsPerStep, estimate.calibrationSteps);
+       printf("ESTIMATED TIME: %.4g s (95%% CI %.4g - %.4g s)\n", estimate.seconds, estimate.secondsLow, estimate.secondsHigh);
 
-           }
-           else{
+   }
+   else{ //  The probes estimate the whole tree, and a search that finds a solution stops before it, often long before.
 
-               printf("|  %d  ", square[i][j]);
+       printf("FULL TREE NODES, UPPER BOUND OF THE SEARCH: %.4g (95%% CI OF THE FULL TREE %.4g - %.4g)\n", estimate.nodes, estimate.nodesLow, estimate.nodesHigh);
+       printf("SECONDS PER STEP: %.4g (%d STEPS TIMED)\n", estimate.secondsPerStep, estimate.calibrationSteps);
+       printf("FULL TREE TIME, UPPER BOUND OF THE SEARCH: %.4g s (95%% CI OF THE FULL TREE %.4g - %.4g s)\n", estimate.seconds, estimate.secondsLow, estimate.secondsHigh);
 
-           }
+   }
 
-       }
+}
 
-       printf("|\n");
+/**
+ *  @brief Solves the Latin Square with a portfolio of solvers that race in parallel.
+ * 
+ *  The result of the solver that finished with the least processor time is displayed like a quiet
+ *  search, and then the configuration, the steps and the processor time of every solver of the portfolio.
+ * 
+ *  @param square 2D array representing the Latin Square.
+ *  @param size The size of the square array.
+ *  @param config Pointer to the base configuration of the solvers.
+ *  @param threads Number of solvers, each in its own thread.
+ *  @param statsName Name of the win statistics file, NULL for none.
+ * 
+ *  @return Returns void.
+ * 
+ */
+void solvePortfolio(int **square, int size, const SOLVER_CONFIG *config, int threads, const char *statsName){
 
-   }
+   PORTFOLIO *portfolio = runPortfolio(square,size,config,threads);
+   PORTFOLIO_ENTRY *winner = &portfolio->entries[portfolio->winner];
 
-   //  Prints the last line of the square
-   for(int i=0; i<size; i++){
+   printResult(winner->solver);
+   printf("PORTFOLIO WINNER: CONFIG %d (%s)\n", winner->index, winner->name);
+   printf("PORTFOLIO TIME: %.6f s\n", portfolio->seconds);
+
+   for(int k=0; k<portfolio->count; k++){
+
+       PORTFOLIO_ENTRY *entry = &portfolio->entries[k];
+       const char *result = (k == portfolio->winner) ? "WON" : (entry->solver->status != SOLVER_RUNNING) ? "FINISHED SLOWER" : "STOPPED AT THE TIME OF THE WINNER";
 
-       printf("+-----");
+       printf("  CONFIG %d (%s): %s, %d STEPS, %.6f s\n", k, entry->name, result, entry->solver->steps, entry->seconds);
 
    }
 
-   printf("+\n");
+   if(statsName != NULL) updateWinStats(portfolio,statsName);
+
+   freePortfolio(portfolio);
 
 }
 
 /**
-*  @brief Finds and returns the first empty cell of the current Latin Square.
-* 
-*  This function finds where an empty cell appears for the first time in the 
-*  current Latin Square and returns the row and column value of that cell.
-* 
-*  @param square 2D array representing the Latin Square.
-*  @param size The size of square array.
-*  @param row Pointer to the row of the first empty cell.
-*  @param col Pointer to the column of the first empty cell.
-* 
-*  @return Returns true if an empty cell was found, else it returns false. 
-* 
-*/
-bool findEmptyCell(int **square, int size, int *row, int *col){
+ *  @brief Reads the next batch of clue edits from a file.
+ * 
+ *  Each line of the file has one clue edit "row column value", where the row and the column start
+ *  from 1 and a value of 0 removes the clue of that cell. Batches are separated by empty lines.
+ * 
+ *  @param editsFile Pointer to the file with the clue edits.
+ *  @param size The size of the Latin Square.
+ *  @param edits Array where the clue edits are stored, it has room for size*size edits.
+ * 
+ *  @return Returns the number of clue edits in the batch, 0 if there are no more batches.
+ * 
+ */
+int readClueEdits(FILE *editsFile, int size, CLUE_EDIT *edits){
 
-   for(int i=0; i<size; i++){
-       
-       for(int j=0; j<size; j++){
+   char line[256];
+   int count = 0;
 
-           if(square[i][j] == 0){ //  If this is true that means an empty cell was found inside the array.
+   while(fgets(line, sizeof(line), editsFile) != NULL){
 
-               *row = i;
-               *col = j;
-               return true;
+       int row, col, value;
+       char extra;
 
-           }
+       if(sscanf(line, " %c", &extra) != 1){ //  An empty line ends the batch.
+
+           if(count > 0) break;
+           continue;
+
+       }
+
+       if(sscanf(line, "%d %d %d %c", &row, &col, &value, &extra) != 3){
+
+           printf("Error! Cannot read clue edit: %s", line);
+           exit(-1);
 
        }
 
+       if(count == size*size){
+
+           printf("Error: Too many clue edits in one batch.\n");
+           exit(-1);
+
+       }
+
+       edits[count].row = row - 1;
+       edits[count].col = col - 1;
+       edits[count].value = value;
+       count++;
+
    }
 
-   return false;
+   return count;
 
 }
 
 /**
- *  @brief Solves the Latin Square using a backtracking algorithm.
+ *  @brief Solves the Latin Square and re-solves it after each batch of clue edits.
  * 
- *  This function solves a Latin Square using a backtracking algorithm and a stack. First it searches for an empty cell.
- *  Then it checks if there is a number that can be inserted in that cell and it does not break the rules of the game.
- *  If there is a valid number it is inserted in the Latin Square and pushed in the stack. If there is not a valid number the
- *  previous state of the Latin Square is popped from the stack and a new number will be found.
- *  If no number can be inserted in any cell then the Latin Square is unsolvable.
+ *  The Latin Square is solved once, then every batch of clue edits from the file is applied to the
+ *  solver, which backtracks only as far as the earliest decision the edits invalidate and continues
+ *  from there instead of starting over.
  * 
  *  @param square 2D array representing the Latin Square.
  *  @param size The size of the square array.
+ *  @param editsFile Pointer to the file with the clue edits.
+ *  @param config Pointer to the configuration of the solver.
  * 
  *  @return Returns void.
  * 
  */
-void solveLatinSquare(int **square, int size){
+void resolveWithEdits(int **square, int size, FILE *editsFile, const SOLVER_CONFIG *config){
 
-   bool solved = false; //  Boolean to check if the Latin Square is solved.
-   int row; //  Row number of the empty cell.
-   int col; //  Column number of the empty cell.
-   findEmptyCell(square,size,&row,&col); //  Finds the first empty cell of the Latin Square.
-   int steps = 0; //  Counter for the total steps.
-   int pushCount = 0; //  Counter for pushes.
-   int popCount = 0; //  Counter for pops.
-   int prevNum = 1; //  Number that will be checked for insertion.
+   SOLVER *solver = initSolver(square,size,config);
+   CLUE_EDIT *edits = (CLUE_EDIT *)malloc(size*size*sizeof(CLUE_EDIT));
+   int count;
+   int batch = 0;
 
-   STACK *stack = initStack();
+   if(edits == NULL){
 
-   while(solved == false){
+       printf("Error: Failed to allocate memory for the clue edits.\n");
+       exit(-1);
 
-        steps++;
-        int validNum; //  Variable to store the valid number that will be inserted in the empty cell.
-        bool numberExists = false; //  Boolean to check if there is a valid number that can be inserted.
+   }
 
-        for(int i=prevNum; i<=size; i++){ //  This for loop checks if there is a valid number that can be inserted in the current empty cell.
+   if(solver->status == SOLVER_SOLVED) printf("The Latin Square is already solved.\n");
 
-            bool found = true; //  Boolean to check if a valid number was found.
+   runSolver(solver,0);
+   printResult(solver);
 
-            for(int j=0; j<size; j++){ //  This for loop checks if the number can be inserted in the current empty cell.
+   while((count = readClueEdits(editsFile,size,edits)) > 0){
 
-                if(abs(square[j][col]) == i || abs(square[row][j]) == i){ //  Checks if the number is already in the same column or row.
+       int depth = solver->stack->size;
+       int pushCount = solver->pushCount;
+       int popCount = solver->popCount;
 
-                    found = false; //  Indicates that the number checked was not valid.
-                    break;
+       batch++;
+       printf("CLUE EDITS %d: %d EDIT(S)\n", batch, count);
 
-                }
+       int resumeDepth = applyClueEdits(solver,edits,count);
 
-            }
+       if(resumeDepth < 0){
 
-            if(found == true){
+           printf("Clue edits %d were not applied.\n", batch);
+           continue;
 
-                validNum = i;
-                numberExists = true;
-                break;
+       }
 
-            }
+       printf("RESUMING FROM STACK DEPTH %d OF %d\n", resumeDepth, depth);
 
-        }
+       if(solver->status == SOLVER_UNSOLVABLE){ //  Added clues cannot make an unsolvable Latin Square solvable.
 
-        if(numberExists == true){ //  A valid number was found, regular push.
+           printf("THE LATIN SQUARE IS UNSOLVABLE!!\n");
 
-            pushCount++;
-            printf("PUSH: STEP %d\n", steps);
-            square[row][col] = validNum; //  Updates the empty cell.
-            push(stack,square,size,row,col);
-            findEmptyCell(square,size,&row,&col); //  Finds the next empty cell of the Latin Square.
-            displayLatinSquare(size,square);
-            solved = isSolved(square,size);
-            prevNum = 1; //  No backtrack case so start checking from value 1.
+       }
+       else{
 
-        }
-        else{ //  A valid number was not found, backtrack case.
+           SOLVER_STATUS status = runSolver(solver,0);
 
-            if(stack->size == 0){ //  If there are no stages to backtrack to then there is no solution.
+           if(status == SOLVER_SOLVED){
 
-                if(steps == 1) displayLatinSquare(size,square);
-                printf("THE LATIN SQUARE IS UNSOLVABLE!!\n");
-                break;
+               displayLatinSquare(size,solver->square);
+               printf("THE LATIN SQUARE IS SOLVED!!\n");
 
-            }
+           }
+           else if(status == SOLVER_UNSOLVABLE && solver->config.verbose == false){ //  The quiet search did not display the verdict.
 
-            popCount++;
-            printf("POP: STEP %d\n", steps);
+               printf("THE LATIN SQUARE IS UNSOLVABLE!!\n");
 
-            NODE *poppedNode = pop(stack); //  Pops the previous state of the Latin Square from the stack.
-            prevNum = poppedNode->square[poppedNode->row][poppedNode->col]; //  Gets the previously inserted number so the search can start from there.
-            prevNum++;
+           }
 
-            for(int i=0; i<size; i++){
+       }
 
-                for(int j=0; j<size; j++){
+       printf("PUSH NUM: %d\n", solver->pushCount - pushCount);
+       printf("POP NUM: %d\n", solver->popCount - popCount);
 
-                    square[i][j] = poppedNode->square[i][j]; //  Copies the previous state of the Latin Square.
+   }
 
-                }
+   free(edits);
+   freeSolver(solver); //  Frees the allocated memory for the solver.
 
-            }
+}
 
-            row = poppedNode->row; //  Row of the previously inserted cell.
-            col = poppedNode->col; //  Column of the previously inserted cell. 
+/**
+ *  @brief Displays how the program is used.
+ * 
+ *  @return Returns void.
+ * 
+ */
+void printUsage(){
+
+   printf("Usage: ./latinSolver [options] <input_file.txt>\n");
+   printf("Options:\n");
+   printf("  --edits <edits_file.txt>        Re-solve after each batch of clue edits in the file.\n");
+   printf("  --cells first|fewest            Fill the first empty cell or the cell with the fewest valid numbers next.\n");
+   printf("  --order ascending|lcv|random    Order in which the numbers of a cell are checked.\n");
+   printf("  --seed <number>                 Seed of the random order.\n");
+   printf("  --restarts luby|geometric       Restart the search after a growing step budget.\n");
+   printf("  --restart-base <steps>          Step budget of the first search before a restart.\n");
+   printf("  --propagate none|root|nodes     Propagate the rows and columns before the search (root) or also after every push (nodes).\n");
+   printf("  --trace <trace_file.bin>        Record every step in a binary trace file (see ./traceReplay).\n");
+   printf("  --generic                       Do not use the kernels specialized for sizes 4-9 and 16.\n");
+   printf("  --estimate                      Estimate the number of nodes and the time of the search instead of solving.\n");
+   printf("  --probes <number>               Number of random probes of the estimate (default %d).\n", DEFAULT_PROBES);
+   printf("  --portfolio                     Race differently configured quiet solvers, one per thread, and display the winner.\n");
+   printf("  --threads <number>              Number of solvers of the portfolio (default one per processor).\n");
+   printf("  --portfolio-stats <stats.txt>   Add the winner of the portfolio to the win statistics in the file.\n");
+   printf("  --quiet                         Do not display every step of the search.\n");
 
-            for(int i=0; i<size; i++) free(poppedNode->square[i]);
-            free(poppedNode->square);
-            free(poppedNode);
-            displayLatinSquare(size,square);
+}
 
-        }
+/**
+ *  @brief Returns the value of a command line option.
+ * 
+ *  @param argc The number of arguments in the command line.
+ *  @param argv An array of strings containing the arguments in the command line.
+ *  @param i Pointer to the index of the option, it is moved to the index of the value.
+ * 
+ *  @return Returns the value of the option.
+ * 
+ */
+char *optionValue(int argc, char *argv[], int *i){
+
+   if(*i + 1 == argc){
+
+       printf("Error: Missing value after %s.\n", argv[*i]);
+       printUsage();
+       exit(-1);
 
    }
 
-   printf("PUSH NUM: %d\n", pushCount);
-   printf("POP NUM: %d\n", popCount);
+   (*i)++;
 
-   freeStack(stack,size); //  Frees the allocated memory for the stack.
+   return argv[*i];
 
 }
 
@@ -390,22 +492,219 @@ void solveLatinSquare(int **square, int size){
  */
 int main(int argc, char *argv[]){
 
-   if(argc > 2){
+   char *inputFile = NULL; //  Name of the input file.
+   char *editsName = NULL; //  Name of the file with the clue edits.
+   bool estimate = false; //  True if the search is estimated instead of solved.
+   int probes = DEFAULT_PROBES; //  Number of random probes of the estimate.
+   bool portfolio = false; //  True if a portfolio of solvers races on the Latin Square.
+   int threads = 0; //  Number of solvers of the portfolio, 0 for one per processor.
+   char *statsName = NULL; //  Name of the win statistics file of the portfolio.
+   SOLVER_CONFIG config; //  Configuration of the solver.
 
-       printf("Error: Too many arguments.\n");
-       printf("Usage: ./latinSolver <input_file.txt>\n");
-       exit(-1);
+   defaultConfig(&config);
+
+   for(int i=1; i<argc; i++){
+
+       if(strcmp(argv[i], "--edits") == 0){
+
+           editsName = optionValue(argc,argv,&i);
+
+       }
+       else if(strcmp(argv[i], "--cells") == 0){
+
+           char *cells = optionValue(argc,argv,&i);
+
+           if(strcmp(cells, "first") == 0) config.cells = CELLS_FIRST_EMPTY;
+           else if(strcmp(cells, "fewest") == 0) config.cells = CELLS_FEWEST;
+           else{
+
+               printf("Error: Unknown cell selection %s.\n", cells);
+               printUsage();
+               exit(-1);
+
+           }
+
+       }
+       else if(strcmp(argv[i], "--order") == 0){
+
+           char *order = optionValue(argc,argv,&i);
+
+           if(strcmp(order, "ascending") == 0) config.order = ORDER_ASCENDING;
+           else if(strcmp(order, "lcv") == 0) config.order = ORDER_LCV;
+           else if(strcmp(order, "random") == 0) config.order = ORDER_RANDOM;
+           else{
+
+               printf("Error: Unknown order %s.\n", order);
+               printUsage();
+               exit(-1);
+
+           }
+
+       }
+       else if(strcmp(argv[i], "--seed") == 0){
+
+           config.seed = (unsigned int)strtoul(optionValue(argc,argv,&i), NULL, 10);
+
+       }
+       else if(strcmp(argv[i], "--restarts") == 0){
+
+           char *restart = optionValue(argc,argv,&i);
+
+           if(strcmp(restart, "luby") == 0) config.restart = RESTART_LUBY;
+           else if(strcmp(restart, "geometric") == 0) config.restart = RESTART_GEOMETRIC;
+           else{
+
+               printf("Error: Unknown restart strategy %s.\n", restart);
+               printUsage();
+               exit(-1);
+
+           }
+
+       }
+       else if(strcmp(argv[i], "--restart-base") == 0){
+
+           config.restartBase = atoi(optionValue(argc,argv,&i));
+
+           if(config.restartBase < 1){
+
+               printf("Error: The restart base must be at least 1 step.\n");
+               exit(-1);
+
+           }
+
+       }
+       else if(strcmp(argv[i], "--propagate") == 0){
+
+           char *propagation = optionValue(argc,argv,&i);
+
+           if(strcmp(propagation, "none") == 0) config.propagation = PROPAGATION_NONE;
+           else if(strcmp(propagation, "root") == 0) config.propagation = PROPAGATION_ROOT;
+           else if(strcmp(propagation, "nodes") == 0) config.propagation = PROPAGATION_NODES;
+           else{
+
+               printf("Error: Unknown propagation %s.\n", propagation);
+               printUsage();
+               exit(-1);
+
+           }
+
+       }
+       else if(strcmp(argv[i], "--trace") == 0){
+
+           config.traceFile = optionValue(argc,argv,&i);
+
+       }
+       else if(strcmp(argv[i], "--generic") == 0){
+
+           config.kernels = false;
+
+       }
+       else if(strcmp(argv[i], "--estimate") == 0){
+
+           estimate = true;
+
+       }
+       else if(strcmp(argv[i], "--probes") == 0){
+
+           probes = atoi(optionValue(argc,argv,&i));
+
+           if(probes < 1){
+
+               printf("Error: The estimate needs at least 1 probe.\n");
+               exit(-1);
+
+           }
+
+       }
+       else if(strcmp(argv[i], "--portfolio") == 0){
+
+           portfolio = true;
+
+       }
+       else if(strcmp(argv[i], "--threads") == 0){
+
+           threads = atoi(optionValue(argc,argv,&i));
+
+           if(threads < 1 || threads > PORTFOLIO_MAX_THREADS){
+
+               printf("Error: The portfolio needs 1 to %d threads.\n", PORTFOLIO_MAX_THREADS);
+               exit(-1);
+
+           }
+
+       }
+       else if(strcmp(argv[i], "--portfolio-stats") == 0){
+
+           statsName = optionValue(argc,argv,&i);
+
+       }
+       else if(strcmp(argv[i], "--quiet") == 0){
+
+           config.verbose = false;
+
+       }
+       else if(argv[i][0] == '-'){
+
+           printf("Error: Unknown option %s.\n", argv[i]);
+           printUsage();
+           exit(-1);
+
+       }
+       else if(inputFile == NULL){
+
+           inputFile = argv[i];
+
+       }
+       else{
+
+           printf("Error: Too many arguments.\n");
+           printUsage();
+           exit(-1);
+
+       }
 
    }
-   else if(argc < 2){
+
+   if(inputFile == NULL){
 
        printf("Error: Not enought arguments.\n");
-       printf("Usage: ./latinSolver <input_file.txt>\n");
+       printUsage();
+       exit(-1);
+
+   }
+
+   if(config.restart != RESTART_NONE && config.order == ORDER_ASCENDING){ //  Every restart would repeat the same search.
+
+       printf("Error: Restarts need a random order (--order random or --order lcv).\n");
+       exit(-1);
+
+   }
+
+   if(estimate == true && editsName != NULL){
+
+       printf("Error: The estimate cannot be combined with clue edits.\n");
+       exit(-1);
+
+   }
+
+   if(portfolio == true && (estimate == true || editsName != NULL || config.traceFile != NULL)){
+
+       printf("Error: The portfolio cannot be combined with the estimate, clue edits or a trace.\n");
+       exit(-1);
+
+   }
+
+   if(portfolio == false && (threads != 0 || statsName != NULL)){
+
+       printf("Error: --threads and --portfolio-stats need --portfolio.\n");
        exit(-1);
 
    }
 
-   FILE *infile = fopen(argv[1], "r");
+   if(threads == 0) threads = defaultThreads();
+
+   FILE *infile = fopen(inputFile, "r");
+   FILE *editsFile = NULL;
    int size;
 
    if(infile == NULL){
@@ -482,9 +781,34 @@ int main(int argc, char *argv[]){
 
    bool solved = readLatinSquare(infile,size,square);
 
-   if(solved == false){
+   if(editsName != NULL){
+
+       editsFile = fopen(editsName, "r");
+
+       if(editsFile == NULL){
+
+           printf("Error: Failed to open the clue edits file.\n");
+           exit(-1);
+
+       }
+
+       resolveWithEdits(square,size,editsFile,&config);
+       fclose(editsFile);
+
+   }
+   else if(solved == false && portfolio == true){
+
+       solvePortfolio(square,size,&config,threads,statsName);
+
+   }
+   else if(solved == false && estimate == true){
+
+       printEstimate(square,size,&config,probes);
+
+   }
+   else if(solved == false){
 
-       solveLatinSquare(square,size);
+       solveLatinSquare(square,size,&config);
 
    }
    else{ //  If the starting Latin Square is solved there is no need to perform changes to it.
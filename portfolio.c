@@ -0,0 +1,379 @@
+/**
+ *  @mainpage Latin Square
+ *  @file portfolio.c
+ *  @brief Source file for the portfolio of solvers that race on one Latin Square.
+ *
+ *  This program runs several solvers on the same Latin Square, one per thread, that
+ *  differ in the cell selection, the order of the numbers and the random seed. No
+ *  configuration is the fastest on every Latin Square, so the solver that finishes with the
+ *  least processor time of its own thread wins, and the rest stop when their time reaches it.
+ *  The processor time does not depend on how the threads share the processors, so the wins of
+ *  each configuration can be added up over many Latin Squares in a statistics file, to choose
+ *  the default configuration.
+ *
+ *  @author Christos Michael (ID: 1135102 / UC1070456)
+ *          Leandros Antoniades (ID: 1119296 / UC1069738)
+ *
+ *  @bug No known bugs.
+ *
+ */
+#define _POSIX_C_SOURCE 200809L //  For sysconf() and clock_gettime().
+
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<time.h>
+#include<unistd.h>
+#include"portfolio.h"
+
+/**
+ *  @brief Finds the default number of threads of a portfolio, one per processor.
+ *
+ *  @return Returns the number of threads, at least 2 so that there is a race.
+ *
+ */
+int defaultThreads(){
+
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if(processors < 2) return 2;
+    if(processors > PORTFOLIO_MAX_THREADS) return PORTFOLIO_MAX_THREADS;
+
+    return (int)processors;
+
+}
+
+/**
+ *  @brief Finds the configuration of a solver of a portfolio.
+ *
+ *  The first solvers are the default search and the fewest valid numbers cell selection with the
+ *  ascending and the least constraining orders, then the random orders with restarts. Every solver
+ *  after the first eight alternates the cell selection and the restart strategy with its own seed.
+ *  The propagation and the restart base come from the base configuration.
+ *
+ *  @param base Pointer to the base configuration.
+ *  @param index Position of the solver in the portfolio.
+ *  @param config Pointer to the configuration that is filled.
+ *
+ */
+void portfolioConfig(const SOLVER_CONFIG *base, int index, SOLVER_CONFIG *config){
+
+    *config = *base;
+    config->verbose = false;
+    config->traceFile = NULL;
+    config->seed = base->seed + index;
+    config->cells = (index % 2 == 0) ? CELLS_FIRST_EMPTY : CELLS_FEWEST;
+
+    switch(index){
+
+        case 0:
+        case 1:
+
+            config->order = ORDER_ASCENDING;
+            config->restart = RESTART_NONE;
+            break;
+
+        case 2:
+        case 3:
+
+            config->order = ORDER_LCV;
+            config->restart = RESTART_NONE;
+            break;
+
+        case 4:
+        case 5:
+
+            config->order = ORDER_RANDOM;
+            config->restart = RESTART_LUBY;
+            break;
+
+        case 6:
+        case 7:
+
+            config->order = ORDER_LCV;
+            config->restart = RESTART_GEOMETRIC;
+            break;
+
+        default:
+
+            config->order = ORDER_RANDOM;
+            config->restart = ((index/2) % 2 == 0) ? RESTART_LUBY : RESTART_GEOMETRIC;
+
+    }
+
+}
+
+/**
+ *  @brief Finds the name of a configuration, e.g. "fewest-lcv-seed3-geometric".
+ *
+ *  @param config Pointer to the configuration.
+ *  @param name Array of PORTFOLIO_NAME_LENGTH characters for the name.
+ *
+ */
+void configName(const SOLVER_CONFIG *config, char *name){
+
+    const char *cells = (config->cells == CELLS_FEWEST) ? "fewest" : "first";
+    const char *order = (config->order == ORDER_LCV) ? "lcv" : (config->order == ORDER_RANDOM) ? "random" : "ascending";
+    const char *restart = (config->restart == RESTART_LUBY) ? "-luby" : (config->restart == RESTART_GEOMETRIC) ? "-geometric" : "";
+
+    if(config->order == ORDER_ASCENDING) snprintf(name, PORTFOLIO_NAME_LENGTH, "%s-%s%s", cells, order, restart); //  The seed does not change the ascending order.
+    else snprintf(name, PORTFOLIO_NAME_LENGTH, "%s-%s-seed%u%s", cells, order, config->seed, restart);
+
+}
+
+/**
+ *  @brief Finds the processor time of the calling thread.
+ *
+ *  @return Returns the processor time in seconds.
+ *
+ */
+static double threadSeconds(){
+
+    struct timespec now;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+
+    return now.tv_sec + now.tv_nsec/1e9;
+
+}
+
+/**
+ *  @brief Runs the solver of a portfolio entry until it finishes or it can no longer win.
+ *
+ *  The thread waits until every thread was created. A solver that finishes wins if its processor
+ *  time is less than the time of the winner so far, and a solver stops when its time reaches the
+ *  time of the winner, so every solver gets the same processor time to beat the winner.
+ *
+ *  @param arg A pointer to the portfolio entry.
+ *
+ *  @return Returns NULL.
+ *
+ */
+static void *raceSolver(void *arg){
+
+    PORTFOLIO_ENTRY *entry = (PORTFOLIO_ENTRY *)arg;
+    bool stopped = false;
+
+    pthread_mutex_lock(entry->lock);
+    while(*entry->started == false) pthread_cond_wait(entry->start, entry->lock);
+    pthread_mutex_unlock(entry->lock);
+
+    while(stopped == false){
+
+        SOLVER_STATUS status = runSolver(entry->solver, PORTFOLIO_CHECK_STEPS);
+
+        entry->seconds = threadSeconds();
+
+        pthread_mutex_lock(entry->lock);
+
+        if(status != SOLVER_RUNNING && (*entry->winner < 0 || entry->seconds < *entry->winnerSeconds)){
+
+            *entry->winner = entry->index;
+            *entry->winnerSeconds = entry->seconds;
+
+        }
+
+        stopped = (status != SOLVER_RUNNING || (*entry->winner >= 0 && entry->seconds >= *entry->winnerSeconds));
+        pthread_mutex_unlock(entry->lock);
+
+    }
+
+    return NULL;
+
+}
+
+/**
+ *  @brief Races a portfolio of solvers on a Latin Square.
+ *
+ *  Every solver is created before the threads start, so the threads do not allocate memory
+ *  for their solvers, and no thread starts its search before every thread was created. The
+ *  function returns after every thread stopped.
+ *
+ *  @param square 2D array representing the Latin Square.
+ *  @param size The size of the square array.
+ *  @param base Pointer to the base configuration of the solvers.
+ *  @param threads Number of solvers, each in its own thread.
+ *
+ *  @return Returns a pointer to the portfolio, with the winner and the solvers.
+ *
+ */
+PORTFOLIO *runPortfolio(int **square, int size, const SOLVER_CONFIG *base, int threads){
+
+    PORTFOLIO *portfolio = (PORTFOLIO *)malloc(sizeof(PORTFOLIO));
+    struct timespec start, end;
+
+    if(portfolio == NULL){
+
+        printf("Error: Failed to allocate memory for the portfolio.\n");
+        exit(-1);
+
+    }
+
+    portfolio->count = threads;
+    portfolio->started = false;
+    portfolio->winner = -1;
+    portfolio->winnerSeconds = 0;
+    portfolio->entries = (PORTFOLIO_ENTRY *)malloc(threads*sizeof(PORTFOLIO_ENTRY));
+
+    if(portfolio->entries == NULL){
+
+        printf("Error: Failed to allocate memory for the portfolio.\n");
+        exit(-1);
+
+    }
+
+    pthread_mutex_init(&portfolio->lock, NULL);
+    pthread_cond_init(&portfolio->start, NULL);
+
+    for(int k=0; k<threads; k++){
+
+        PORTFOLIO_ENTRY *entry = &portfolio->entries[k];
+        SOLVER_CONFIG config;
+
+        portfolioConfig(base, k, &config);
+        configName(&config, entry->name);
+        entry->index = k;
+        entry->solver = initSolver(square, size, &config);
+        entry->seconds = 0;
+        entry->lock = &portfolio->lock;
+        entry->start = &portfolio->start;
+        entry->started = &portfolio->started;
+        entry->winner = &portfolio->winner;
+        entry->winnerSeconds = &portfolio->winnerSeconds;
+
+    }
+
+    for(int k=0; k<threads; k++){
+
+        if(pthread_create(&portfolio->entries[k].thread, NULL, raceSolver, &portfolio->entries[k]) != 0){
+
+            printf("Error: Failed to create the thread of solver %d.\n", k);
+            exit(-1);
+
+        }
+
+    }
+
+    //  Starts the race once every thread exists, so no solver gets a head start.
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_mutex_lock(&portfolio->lock);
+    portfolio->started = true;
+    pthread_cond_broadcast(&portfolio->start);
+    pthread_mutex_unlock(&portfolio->lock);
+
+    for(int k=0; k<threads; k++) pthread_join(portfolio->entries[k].thread, NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    portfolio->seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec)/1e9;
+
+    return portfolio;
+
+}
+
+/**
+ *  @brief Adds the result of a portfolio to a win statistics file and displays the statistics.
+ *
+ *  Each line of the file is "runs wins name" for one configuration. The file is created if it does
+ *  not exist, and the configurations that are not in the portfolio are kept as they are.
+ *
+ *  @param portfolio A pointer to the portfolio, after the race.
+ *  @param statsName Name of the win statistics file.
+ *
+ */
+void updateWinStats(PORTFOLIO *portfolio, const char *statsName){
+
+    char (*names)[PORTFOLIO_NAME_LENGTH] = malloc(PORTFOLIO_MAX_STATS*sizeof(*names));
+    int *runs = (int *)malloc(PORTFOLIO_MAX_STATS*sizeof(int));
+    int *wins = (int *)malloc(PORTFOLIO_MAX_STATS*sizeof(int));
+    int count = 0; //  Number of configurations in the statistics.
+    FILE *file = fopen(statsName, "r");
+
+    if(names == NULL || runs == NULL || wins == NULL){
+
+        printf("Error: Failed to allocate memory for the win statistics.\n");
+        exit(-1);
+
+    }
+
+    if(file != NULL){ //  A missing file has no statistics yet.
+
+        while(count < PORTFOLIO_MAX_STATS && fscanf(file, "%d %d %63s", &runs[count], &wins[count], names[count]) == 3) count++;
+
+        if(!feof(file) && count < PORTFOLIO_MAX_STATS){
+
+            printf("Error: The win statistics file is not valid.\n");
+            exit(-1);
+
+        }
+
+        fclose(file);
+
+    }
+
+    printf("WIN STATISTICS:\n");
+
+    for(int k=0; k<portfolio->count; k++){
+
+        int s = 0;
+
+        while(s < count && strcmp(names[s], portfolio->entries[k].name) != 0) s++;
+
+        if(s == count){ //  A new configuration.
+
+            if(count == PORTFOLIO_MAX_STATS){
+
+                printf("Error: The win statistics file has too many configurations.\n");
+                exit(-1);
+
+            }
+
+            strcpy(names[s], portfolio->entries[k].name);
+            runs[s] = 0;
+            wins[s] = 0;
+            count++;
+
+        }
+
+        runs[s]++;
+        if(k == portfolio->winner) wins[s]++;
+
+        printf("  %s: %d WINS IN %d RUNS (%.1f%%)\n", names[s], wins[s], runs[s], 100.0*wins[s]/runs[s]);
+
+    }
+
+    file = fopen(statsName, "w");
+
+    if(file == NULL){
+
+        printf("Error: Failed to write the win statistics file.\n");
+        exit(-1);
+
+    }
+
+    for(int s=0; s<count; s++) fprintf(file, "%d %d %s\n", runs[s], wins[s], names[s]);
+
+    fclose(file);
+    free(names);
+    free(runs);
+    free(wins);
+
+}
+
+/**
+ *  @brief Frees all memory that was allocated for a portfolio.
+ *
+ *  @param portfolio A pointer to the portfolio to be freed.
+ *
+ */
+void freePortfolio(PORTFOLIO *portfolio){
+
+    if(portfolio == NULL) return;
+
+    for(int k=0; k<portfolio->count; k++) freeSolver(portfolio->entries[k].solver);
+
+    pthread_mutex_destroy(&portfolio->lock);
+    pthread_cond_destroy(&portfolio->start);
+    free(portfolio->entries);
+    free(portfolio);
+
+}
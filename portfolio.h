@@ -0,0 +1,75 @@
+/**
+ *  @mainpage Latin Square
+ *  @file portfolio.h
+ *  @brief Header file for the portfolio of solvers that race on one Latin Square.
+ *
+ *  This program contains the portfolio data structures and the function declarations
+ *  for running differently configured solvers on the same Latin Square, one per thread,
+ *  until the first of them finishes.
+ *
+ *  @author Christos Michael (ID: 1135102 / UC1070456)
+ *          Leandros Antoniades (ID: 1119296 / UC1069738)
+ *
+ *  @bug No known bugs.
+ *
+ */
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include<stdbool.h>
+#include<pthread.h>
+#include"solver.h"
+
+#define PORTFOLIO_CHECK_STEPS 1024 //  Steps a solver runs between checks of the cancel flag.
+#define PORTFOLIO_MAX_THREADS 64
+#define PORTFOLIO_NAME_LENGTH 64 //  Maximum length of the name of a configuration.
+#define PORTFOLIO_MAX_STATS 256 //  Maximum number of configurations in a win statistics file.
+
+/**
+ *  @brief Represents one solver of a portfolio and the thread that runs it.
+ *
+ *  The solver has its own Latin Square and stack, so the threads only share the start flag
+ *  and the winner, which they check under the lock every PORTFOLIO_CHECK_STEPS steps.
+ *
+ */
+typedef struct{
+
+    int index; //  Position of the solver in the portfolio.
+    char name[PORTFOLIO_NAME_LENGTH]; //  Name of the configuration, for the win statistics.
+    SOLVER *solver;
+    double seconds; //  Processor time of the thread when its solver finished or stopped.
+    pthread_t thread;
+    pthread_mutex_t *lock; //  Lock of the start flag and the winner of the portfolio.
+    pthread_cond_t *start; //  Signals the threads when the start flag is set.
+    bool *started; //  Start flag of the portfolio, set after every thread was created.
+    int *winner; //  Winner of the portfolio.
+    double *winnerSeconds; //  Processor time of the winner, the solvers stop when theirs reaches it.
+
+}PORTFOLIO_ENTRY;
+
+/**
+ *  @brief Represents a portfolio of solvers that race on one Latin Square.
+ *
+ */
+typedef struct{
+
+    int count; //  Number of solvers.
+    PORTFOLIO_ENTRY *entries;
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    bool started;
+    int winner; //  Index of the solver that finished with the least processor time, -1 while none finished.
+    double winnerSeconds;
+    double seconds; //  Wall clock time of the race.
+
+}PORTFOLIO;
+
+//  Portfolio function declarations.
+int defaultThreads();
+void portfolioConfig(const SOLVER_CONFIG *base, int index, SOLVER_CONFIG *config);
+void configName(const SOLVER_CONFIG *config, char *name);
+PORTFOLIO *runPortfolio(int **square, int size, const SOLVER_CONFIG *base, int threads);
+void updateWinStats(PORTFOLIO *portfolio, const char *statsName);
+void freePortfolio(PORTFOLIO *portfolio);
+
+#endif
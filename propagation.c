@@ -0,0 +1,514 @@
+/**
+ *  @mainpage Latin Square
+ *  @file propagation.c
+ *  @brief Source file for the all-different propagation of the Latin Square.
+ *
+ *  This program enforces generalized arc consistency on the all-different constraint of
+ *  every row and every column using Regin's algorithm. A matching between the cells and
+ *  the numbers of a constraint shows if the constraint can still be satisfied, and the
+ *  strongly connected components of the matching graph show which numbers of a cell
+ *  cannot be part of any solution of the constraint, so they are removed from its domain.
+ *  During a search the domains are updated incrementally: inserting a number only queues
+ *  the row and the column of its cell, another row or column is queued only when one of
+ *  its domains changes, and the removed numbers are restored when the search backtracks.
+ *
+ *  @author Christos Michael (ID: 1135102 / UC1070456)
+ *          Leandros Antoniades (ID: 1119296 / UC1069738)
+ *
+ *  @bug No known bugs.
+ *
+ */
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include"propagation.h"
+
+/**
+ *  @brief Returns the domain of a position of a constraint.
+ *
+ *  @param prop A pointer to the propagator.
+ *  @param k The constraint, a row for k < size else a column.
+ *  @param p The position of the cell in the constraint.
+ *
+ *  @return Returns a pointer to the domain, indexed by number.
+ *
+ */
+static char *cellDomain(PROPAGATOR *prop, int k, int p){
+
+    int size = prop->size;
+
+    if(k < size) return prop->domain + (k*size + p)*(size + 1);
+    else return prop->domain + (p*size + (k - size))*(size + 1);
+
+}
+
+/**
+ *  @brief Allocates memory for a propagator array.
+ *
+ *  @param count The number of elements.
+ *  @param elementSize The size of each element.
+ *
+ *  @return Returns a pointer to the array.
+ *
+ */
+static void *allocArray(int count, size_t elementSize){
+
+    void *array = malloc(count*elementSize);
+
+    if(array == NULL){
+
+        printf("Error: Failed to allocate memory for the propagator.\n");
+        exit(-1);
+
+    }
+
+    return array;
+
+}
+
+/**
+ *  @brief Initializes a new propagator for a Latin Square.
+ *
+ *  @param size The size of the Latin Square.
+ *
+ *  @return Returns a pointer to the propagator.
+ *
+ */
+PROPAGATOR *initPropagator(int size){
+
+    PROPAGATOR *prop = (PROPAGATOR *)allocArray(1, sizeof(PROPAGATOR));
+
+    prop->size = size;
+    prop->domain = (char *)allocArray(size*size*(size + 1), sizeof(char));
+    prop->matchValue = (int *)allocArray(2*size*size, sizeof(int));
+    prop->matchPos = (int *)allocArray(2*size*(size + 1), sizeof(int));
+    prop->visited = (char *)allocArray(size + 1, sizeof(char));
+    prop->index = (int *)allocArray(2*size, sizeof(int));
+    prop->lowLink = (int *)allocArray(2*size, sizeof(int));
+    prop->component = (int *)allocArray(2*size, sizeof(int));
+    prop->nodes = (int *)allocArray(2*size, sizeof(int));
+    prop->onStack = (char *)allocArray(2*size, sizeof(char));
+    prop->trail = (int *)allocArray(size*size*(size + 1), sizeof(int)); //  A number is removed at most once from each domain until it is restored.
+    prop->levelStart = (int *)allocArray(size*size + 1, sizeof(int));
+    prop->queue = (int *)allocArray(2*size, sizeof(int));
+    prop->queued = (char *)allocArray(2*size, sizeof(char));
+    prop->trailSize = 0;
+    prop->levels = 0;
+    prop->queueHead = 0;
+    prop->queueSize = 0;
+
+    for(int i=0; i<2*size*size; i++) prop->matchValue[i] = 0;
+    for(int i=0; i<2*size*(size + 1); i++) prop->matchPos[i] = -1;
+    for(int k=0; k<2*size; k++) prop->queued[k] = 0;
+
+    return prop;
+
+}
+
+/**
+ *  @brief Adds a constraint to the queue of the constraints that have to be filtered.
+ *
+ *  @param prop A pointer to the propagator.
+ *  @param k The constraint.
+ *
+ */
+static void enqueue(PROPAGATOR *prop, int k){
+
+    int size = prop->size;
+
+    if(prop->queued[k] == 1) return;
+
+    prop->queued[k] = 1;
+    prop->queue[(prop->queueHead + prop->queueSize) % (2*size)] = k;
+    prop->queueSize++;
+
+}
+
+/**
+ *  @brief Removes a number from the domain of a position of a constraint.
+ *
+ *  The removal is recorded in the trail, and the other constraint of the cell is queued,
+ *  since its domains changed.
+ *
+ *  @param prop A pointer to the propagator.
+ *  @param k The constraint.
+ *  @param p The position of the cell in the constraint.
+ *  @param v The number.
+ *
+ */
+static void removeValue(PROPAGATOR *prop, int k, int p, int v){
+
+    int size = prop->size;
+    char *domain = cellDomain(prop, k, p);
+
+    domain[v] = 0;
+    prop->trail[prop->trailSize++] = (int)(domain - prop->domain) + v;
+    enqueue(prop, (k < size) ? size + p : p);
+
+}
+
+/**
+ *  @brief Searches for an augmenting path that matches a position of a constraint.
+ *
+ *  @param prop A pointer to the propagator.
+ *  @param k The constraint.
+ *  @param p The position that is matched.
+ *
+ *  @return Returns true if the position was matched, else it returns false.
+ *
+ */
+static bool augment(PROPAGATOR *prop, int k, int p){
+
+    int size = prop->size;
+    char *domain = cellDomain(prop, k, p);
+    int *matchPos = prop->matchPos + k*(size + 1);
+
+    for(int v=1; v<=size; v++){
+
+        if(domain[v] == 0 || prop->visited[v] == 1) continue;
+
+        prop->visited[v] = 1;
+
+        if(matchPos[v] < 0 || augment(prop, k, matchPos[v]) == true){
+
+            matchPos[v] = p;
+            prop->matchValue[k*size + p] = v;
+            return true;
+
+        }
+
+    }
+
+    return false;
+
+}
+
+/**
+ *  @brief Finds the strongly connected component of a node of the matching graph (Tarjan's algorithm).
+ *
+ *  Nodes 0 to size-1 are the positions of the constraint and nodes size to 2*size-1 are the numbers.
+ *  A position points to the numbers of its domain that it is not matched to, and a number points to
+ *  the position it is matched to.
+ *
+ *  @param prop A pointer to the propagator.
+ *  @param k The constraint.
+ *  @param node The node.
+ *
+ */
+static void strongConnect(PROPAGATOR *prop, int k, int node){
+
+    int size = prop->size;
+
+    prop->index[node] = prop->counter;
+    prop->lowLink[node] = prop->counter;
+    prop->counter++;
+    prop->nodes[prop->top++] = node;
+    prop->onStack[node] = 1;
+
+    for(int v=1; v<=size; v++){
+
+        int next; //  The node the edge points to.
+
+        if(node < size){
+
+            if(cellDomain(prop, k, node)[v] == 0 || prop->matchValue[k*size + node] == v) continue;
+            next = size + v - 1;
+
+        }
+        else{
+
+            if(v > 1) break; //  A number has a single edge, to its matched position.
+            next = prop->matchPos[k*(size + 1) + (node - size + 1)];
+
+        }
+
+        if(prop->index[next] < 0){
+
+            strongConnect(prop, k, next);
+            if(prop->lowLink[next] < prop->lowLink[node]) prop->lowLink[node] = prop->lowLink[next];
+
+        }
+        else if(prop->onStack[next] == 1 && prop->index[next] < prop->lowLink[node]){
+
+            prop->lowLink[node] = prop->index[next];
+
+        }
+
+    }
+
+    if(prop->lowLink[node] == prop->index[node]){ //  The node is the root of a component.
+
+        int member;
+
+        do{
+
+            member = prop->nodes[--prop->top];
+            prop->onStack[member] = 0;
+            prop->component[member] = prop->components;
+
+        }while(member != node);
+
+        prop->components++;
+
+    }
+
+}
+
+/**
+ *  @brief Enforces generalized arc consistency on one all-different constraint.
+ *
+ *  The matching of the constraint is repaired, and every number of a domain whose edge is not in
+ *  the matching and joins two different strongly connected components is removed, since no
+ *  matching that covers every position can use it.
+ *
+ *  @param prop A pointer to the propagator.
+ *  @param k The constraint.
+ *
+ *  @return Returns the number of removed numbers, or -1 if the constraint cannot be satisfied.
+ *
+ */
+static int filterConstraint(PROPAGATOR *prop, int k){
+
+    int size = prop->size;
+    int *matchValue = prop->matchValue + k*size;
+    int *matchPos = prop->matchPos + k*(size + 1);
+    int removed = 0;
+
+    //  Breaks the matches whose number is no longer in the domain of the position.
+    for(int p=0; p<size; p++){
+
+        if(matchValue[p] != 0 && cellDomain(prop, k, p)[matchValue[p]] == 0){
+
+            matchPos[matchValue[p]] = -1;
+            matchValue[p] = 0;
+
+        }
+
+    }
+
+    for(int p=0; p<size; p++){
+
+        if(matchValue[p] != 0) continue;
+
+        memset(prop->visited, 0, size + 1);
+        if(augment(prop, k, p) == false) return -1; //  The cells of the constraint cannot all get different numbers.
+
+    }
+
+    for(int node=0; node<2*size; node++){
+
+        prop->index[node] = -1;
+        prop->onStack[node] = 0;
+
+    }
+
+    prop->counter = 0;
+    prop->top = 0;
+    prop->components = 0;
+
+    for(int node=0; node<2*size; node++){
+
+        if(prop->index[node] < 0) strongConnect(prop, k, node);
+
+    }
+
+    for(int p=0; p<size; p++){
+
+        char *domain = cellDomain(prop, k, p);
+
+        for(int v=1; v<=size; v++){
+
+            if(domain[v] == 1 && matchValue[p] != v && prop->component[p] != prop->component[size + v - 1]){
+
+                removeValue(prop, k, p, v);
+                removed++;
+
+            }
+
+        }
+
+    }
+
+    return removed;
+
+}
+
+/**
+ *  @brief Filters the queued constraints until the queue is empty.
+ *
+ *  @param prop A pointer to the propagator.
+ *
+ *  @return Returns false if a constraint cannot be satisfied, else it returns true.
+ *
+ */
+static bool filterQueue(PROPAGATOR *prop){
+
+    int size = prop->size;
+
+    while(prop->queueSize > 0){
+
+        int k = prop->queue[prop->queueHead];
+
+        prop->queueHead = (prop->queueHead + 1) % (2*size);
+        prop->queueSize--;
+        prop->queued[k] = 0;
+
+        if(filterConstraint(prop, k) < 0){ //  Empties the queue for the next call.
+
+            while(prop->queueSize > 0){
+
+                prop->queued[prop->queue[prop->queueHead]] = 0;
+                prop->queueHead = (prop->queueHead + 1) % (2*size);
+                prop->queueSize--;
+
+            }
+
+            return false;
+
+        }
+
+    }
+
+    return true;
+
+}
+
+/**
+ *  @brief Propagates the all-different constraints of a Latin Square from scratch.
+ *
+ *  The domain of each filled cell is its number and the domain of each empty cell is the numbers
+ *  that are not in the same row or column. Then every row and column is filtered until no domain
+ *  changes. The trail is cleared, so the result is the level that assignCell() builds on.
+ *
+ *  @param prop A pointer to the propagator.
+ *  @param square 2D array representing the Latin Square.
+ *
+ *  @return Returns false if the Latin Square is unsolvable, else it returns true.
+ *
+ */
+bool propagate(PROPAGATOR *prop, int **square){
+
+    int size = prop->size;
+
+    for(int i=0; i<size; i++){
+
+        for(int j=0; j<size; j++){
+
+            char *domain = prop->domain + (i*size + j)*(size + 1);
+            int value = abs(square[i][j]);
+
+            memset(domain, value == 0, size + 1);
+
+            if(value != 0){
+
+                domain[value] = 1;
+                continue;
+
+            }
+
+            for(int m=0; m<size; m++){
+
+                domain[abs(square[i][m])] = 0;
+                domain[abs(square[m][j])] = 0;
+
+            }
+
+        }
+
+    }
+
+    for(int k=0; k<2*size; k++) enqueue(prop, k);
+
+    bool consistent = filterQueue(prop);
+
+    prop->trailSize = 0;
+    prop->levels = 0;
+
+    return consistent;
+
+}
+
+/**
+ *  @brief Propagates a number that the search inserted in a cell.
+ *
+ *  A new level is started and the domain of the cell becomes the number. Only the row and the
+ *  column of the cell are queued, and the other rows and columns are queued by removeValue()
+ *  when their domains change. The level is undone with undoAssign(), also when it failed.
+ *
+ *  @param prop A pointer to the propagator, after propagate() on the Latin Square without the number.
+ *  @param row Row of the cell.
+ *  @param col Column of the cell.
+ *  @param value The number.
+ *
+ *  @return Returns false if the Latin Square became unsolvable, else it returns true.
+ *
+ */
+bool assignCell(PROPAGATOR *prop, int row, int col, int value){
+
+    int size = prop->size;
+    char *domain = cellDomain(prop, row, col);
+
+    prop->levelStart[prop->levels++] = prop->trailSize;
+
+    if(domain[value] == 0) return false; //  The number was already ruled out.
+
+    for(int v=1; v<=size; v++){
+
+        if(v != value && domain[v] == 1){
+
+            domain[v] = 0;
+            prop->trail[prop->trailSize++] = (int)(domain - prop->domain) + v;
+
+        }
+
+    }
+
+    enqueue(prop, row);
+    enqueue(prop, size + col);
+
+    return filterQueue(prop);
+
+}
+
+/**
+ *  @brief Restores the domains from before the last number that was propagated by assignCell().
+ *
+ *  The matchings are kept, since restoring numbers only adds edges to the matching graphs.
+ *
+ *  @param prop A pointer to the propagator.
+ *
+ */
+void undoAssign(PROPAGATOR *prop){
+
+    int start = prop->levelStart[--prop->levels];
+
+    while(prop->trailSize > start) prop->domain[prop->trail[--prop->trailSize]] = 1;
+
+}
+
+/**
+ *  @brief Frees all memory that was allocated for a propagator.
+ *
+ *  @param prop A pointer to the propagator to be freed.
+ *
+ */
+void freePropagator(PROPAGATOR *prop){
+
+    if(prop == NULL) return;
+
+    free(prop->domain);
+    free(prop->matchValue);
+    free(prop->matchPos);
+    free(prop->visited);
+    free(prop->index);
+    free(prop->lowLink);
+    free(prop->component);
+    free(prop->nodes);
+    free(prop->onStack);
+    free(prop->trail);
+    free(prop->levelStart);
+    free(prop->queue);
+    free(prop->queued);
+    free(prop);
+
+}
@@ -0,0 +1,66 @@
+/**
+ *  @mainpage Latin Square
+ *  @file propagation.h
+ *  @brief Header file for the all-different propagation of the Latin Square.
+ *
+ *  This program contains the propagator data structure and the function declarations
+ *  for enforcing generalized arc consistency on the all-different constraint of every
+ *  row and every column of a Latin Square, once from scratch or incrementally after
+ *  each number that the search inserts.
+ *
+ *  @author Christos Michael (ID: 1135102 / UC1070456)
+ *          Leandros Antoniades (ID: 1119296 / UC1069738)
+ *
+ *  @bug No known bugs.
+ *
+ */
+#ifndef PROPAGATION_H
+#define PROPAGATION_H
+
+#include<stdbool.h>
+
+/**
+ *  @brief Represents a propagator for the rows and columns of a Latin Square.
+ *
+ *  Constraint k is row k for k < size and column k - size for the rest, and position p of a
+ *  constraint is the p-th cell of that row or column. The matchings of the constraints are kept
+ *  between calls, so during a search only the matches that were broken have to be repaired.
+ *  Every number that is removed from a domain is recorded in the trail, so the domains of a
+ *  level can be restored when the search backtracks, and only the rows and columns whose
+ *  domains changed are queued to be filtered again.
+ *
+ */
+typedef struct{
+
+    int size;
+    char *domain; //  Possible numbers of each cell, domain[(row*size + col)*(size + 1) + number].
+    int *matchValue; //  Number matched to each position of each constraint, matchValue[k*size + p], 0 if none.
+    int *matchPos; //  Position matched to each number of each constraint, matchPos[k*(size + 1) + number], -1 if none.
+    char *visited; //  Numbers visited while searching for an augmenting path.
+    int *index; //  Order in which the search for strongly connected components visited each node, -1 if not visited.
+    int *lowLink; //  Smallest index reachable from each node.
+    int *component; //  Strongly connected component of each node.
+    int *nodes; //  Stack of the nodes of the components that are not finished.
+    char *onStack;
+    int counter;
+    int top;
+    int components;
+    int *trail; //  Removed numbers, as offsets in the domains, in the order they were removed.
+    int trailSize;
+    int *levelStart; //  Size of the trail when each level started.
+    int levels; //  Number of inserted numbers that can be undone.
+    int *queue; //  Circular queue of the constraints that have to be filtered.
+    char *queued; //  Marks of the constraints in the queue.
+    int queueHead;
+    int queueSize;
+
+}PROPAGATOR;
+
+//  Propagator function declarations.
+PROPAGATOR *initPropagator(int size);
+bool propagate(PROPAGATOR *prop, int **square);
+bool assignCell(PROPAGATOR *prop, int row, int col, int value);
+void undoAssign(PROPAGATOR *prop);
+void freePropagator(PROPAGATOR *prop);
+
+#endif
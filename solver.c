@@ -0,0 +1,1217 @@
+/**
+ *  @mainpage Latin Square
+ *  @file solver.c
+ *  @brief Source file for the backtracking solver of the Latin Square.
+ *
+ *  This program contains the functions that check, display and solve a Latin Square
+ *  using a backtracking algorithm and a stack. The search can be stopped and resumed,
+ *  and it can be resumed after clue edits without starting over. The numbers of a cell
+ *  are checked in ascending, least constraining or random order, the search can be
+ *  restarted after a growing step budget, and the all-different propagation of the rows
+ *  and columns can reject unsolvable Latin Squares before the search and prune it.
+ *
+ *  @author Christos Michael (ID: 1135102 / UC1070456)
+ *          Leandros Antoniades (ID: 1119296 / UC1069738)
+ *
+ *  @bug No known bugs.
+ *
+ */
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<limits.h>
+#include<math.h>
+#include"solver.h"
+
+/**
+ *  @brief Checks if the Latin Square is solved.
+ *
+ *  This function checks if the Latin Square is solved by checking if there are any empty squares.
+ *  Assuming that only valid values were inserted in the Latin Square.
+ *
+ *  @param square 2D array representing the Latin Square.
+ *  @param size The size of the square array.
+ *
+ *  @return Returns true if the Latin Square is solved, else it returns false.
+ *
+ */
+bool isSolved(int **square, int size){
+
+    int count = 0;
+
+    //  Assuming that only valid Latin Square are read from the file if there are no emtpy cells that means that the Latin Square is solved
+    for(int i=0; i<size; i++){
+
+        for(int j=0; j<size; j++){
+
+            if(square[i][j] == 0){
+
+                count++;
+
+            }
+
+        }
+
+    }
+
+    if(count == 0){
+
+        return true;
+
+    }
+    else{
+
+        return false;
+
+    }
+
+}
+
+/**
+ *  @brief Displays the Latin Square on the screen.
+ *
+ *  This function displays the Latin Square on the screen within a border.
+ *
+ *  @param size The size of the Latin Square.
+ *  @param square 2D array representing the Latin Square.
+ *
+ *  @return Void.
+ *
+ */
+void displayLatinSquare(int size, int **square){
+
+    for(int i=0; i<size; i++){
+
+        //  Prints the lines of the square
+        for(int j=0; j<size; j++){
+
+            printf("+-----");
+
+        }
+
+        printf("+");
+        printf("\n");
+
+        for(int j=0; j<size; j++){
+
+            if(square[i][j] < 0){
+
+                printf("| (%d) ", abs(square[i][j]));
+
+            }
+            else{
+
+                printf("|  %d  ", square[i][j]);
+
+            }
+
+        }
+
+        printf("|\n");
+
+    }
+
+    //  Prints the last line of the square
+    for(int i=0; i<size; i++){
+
+        printf("+-----");
+
+    }
+
+    printf("+\n");
+
+}
+
+/**
+ *  @brief Finds and returns the first empty cell of the current Latin Square.
+ *
+ *  This function finds where an empty cell appears for the first time in the
+ *  current Latin Square and returns the row and column value of that cell.
+ *
+ *  @param square 2D array representing the Latin Square.
+ *  @param size The size of square array.
+ *  @param row Pointer to the row of the first empty cell.
+ *  @param col Pointer to the column of the first empty cell.
+ *
+ *  @return Returns true if an empty cell was found, else it returns false.
+ *
+ */
+bool findEmptyCell(int **square, int size, int *row, int *col){
+
+    for(int i=0; i<size; i++){
+
+        for(int j=0; j<size; j++){
+
+            if(square[i][j] == 0){ //  If this is true that means an empty cell was found inside the array.
+
+                *row = i;
+                *col = j;
+                return true;
+
+            }
+
+        }
+
+    }
+
+    return false;
+
+}
+
+/**
+ *  @brief Finds the empty cell of the current Latin Square with the fewest valid numbers.
+ *
+ *  The numbers used in each row and column are marked once, and then every empty cell counts the
+ *  numbers that are not marked in its row or column. Ties go to the first cell, and a cell with no
+ *  valid numbers is returned immediately, since the search has to backtrack from it.
+ *
+ *  @param square 2D array representing the Latin Square.
+ *  @param size The size of square array.
+ *  @param used Array of 2*size*(size + 1) marks for the numbers used in each row and column.
+ *  @param row Pointer to the row of the cell.
+ *  @param col Pointer to the column of the cell.
+ *
+ *  @return Returns true if an empty cell was found, else it returns false.
+ *
+ */
+bool findFewestCell(int **square, int size, char *used, int *row, int *col){
+
+    char *colUsed = used;
+    char *rowUsed = used + size*(size + 1);
+    int fewest = size + 1; //  Number of valid numbers of the best cell so far.
+
+    memset(used, 0, 2*size*(size + 1));
+
+    for(int i=0; i<size; i++){
+
+        for(int j=0; j<size; j++){
+
+            int value = abs(square[i][j]);
+
+            colUsed[j*(size + 1) + value] = 1;
+            rowUsed[i*(size + 1) + value] = 1;
+
+        }
+
+    }
+
+    for(int i=0; i<size; i++){
+
+        for(int j=0; j<size; j++){
+
+            if(square[i][j] != 0) continue;
+
+            int count = 0;
+
+            for(int v=1; v<=size && count<fewest; v++) if(colUsed[j*(size + 1) + v] == 0 && rowUsed[i*(size + 1) + v] == 0) count++;
+
+            if(count < fewest){
+
+                fewest = count;
+                *row = i;
+                *col = j;
+                if(count == 0) return true;
+
+            }
+
+        }
+
+    }
+
+    return fewest <= size;
+
+}
+
+/**
+ *  @brief Allocates a 2D array for a Latin Square.
+ *
+ *  @param size The size of the square array.
+ *
+ *  @return Returns a pointer to the 2D array, with every cell set to 0.
+ *
+ */
+static int **allocSquare(int size){
+
+    int **square = (int **)malloc(size*sizeof(int *));
+
+    if(square == NULL){
+
+        printf("Error: Failed to allocate memory for the solver.(rows)\n");
+        exit(-1);
+
+    }
+
+    for(int i=0; i<size; i++){
+
+        square[i] = (int *)calloc(size, sizeof(int));
+
+        if(square[i] == NULL){
+
+            printf("Error: Failed to allocate memory for the solver.(columns)\n");
+            for(int j=0; j<i; j++) free(square[j]); //  Frees the already allocated memory.
+            free(square);
+            exit(-1);
+
+        }
+
+    }
+
+    return square;
+
+}
+
+/**
+ *  @brief Frees a 2D array of a Latin Square.
+ *
+ *  @param square 2D array representing the Latin Square.
+ *  @param size The size of the square array.
+ *
+ */
+static void freeSquare(int **square, int size){
+
+    for(int i=0; i<size; i++) free(square[i]);
+    free(square);
+
+}
+
+/**
+ *  @brief Frees a node that was popped from the stack.
+ *
+ *  @param node The popped node.
+ *  @param size The size of the Latin Square stored in the node.
+ *
+ */
+static void freeNode(NODE *node, int size){
+
+    freeSquare(node->square, size);
+    free(node);
+
+}
+
+/**
+ *  @brief Changes a cell of the Latin Square outside of the search and records it in the trace.
+ *
+ *  The clue edits change cells that no push or pop shows, so the trace records the change.
+ *
+ *  @param solver A pointer to the solver.
+ *  @param row The row of the cell.
+ *  @param col The column of the cell.
+ *  @param value The new number of the cell, negative for a clue, 0 to empty it.
+ *
+ */
+static void setCell(SOLVER *solver, int row, int col, int value){
+
+    solver->square[row][col] = value;
+    if(solver->trace != NULL) traceRecord(solver->trace, solver->steps, TRACE_CELL, row, col, abs(value));
+
+}
+
+/**
+ *  @brief Restores the Latin Square from a popped node.
+ *
+ *  The cells are copied from the state stored in the node, but the clues always come from the
+ *  current clues of the solver, and a filled cell is only kept if a decision that is still in the
+ *  stack (or the popped decision itself) filled it. Without clue edits this is a plain copy.
+ *
+ *  @param solver A pointer to the solver.
+ *  @param node The popped node.
+ *
+ */
+static void restoreSquare(SOLVER *solver, NODE *node){
+
+    for(int i=0; i<solver->size; i++){
+
+        for(int j=0; j<solver->size; j++){
+
+            int value = node->square[i][j];
+
+            if(solver->clues[i][j] != 0){
+
+                solver->square[i][j] = solver->clues[i][j];
+
+            }
+            else if(value > 0 && (solver->decisionAt[i][j] != 0 || (i == node->row && j == node->col))){
+
+                solver->square[i][j] = value;
+
+            }
+            else{
+
+                solver->square[i][j] = 0;
+
+            }
+
+        }
+
+    }
+
+}
+
+/**
+ *  @brief Pops the top node from the stack of the solver.
+ *
+ *  @param solver A pointer to the solver.
+ *
+ *  @return Returns the popped node.
+ *
+ */
+static NODE *popDecision(SOLVER *solver){
+
+    //  The domains of the popped decision are undone, the domains of the decision before it are still up to date.
+    if(solver->propDepth == solver->stack->size && solver->propagator->levels > 0){
+
+        undoAssign(solver->propagator);
+        solver->propDepth--;
+
+    }
+    else if(solver->propDepth != solver->stack->size - 1){
+
+        solver->propDepth = -1;
+
+    }
+
+    NODE *poppedNode = pop(solver->stack);
+    solver->decisionAt[poppedNode->row][poppedNode->col] = 0;
+    solver->popCount++;
+
+    if(solver->trace != NULL) traceRecord(solver->trace, solver->steps, TRACE_POP, poppedNode->row, poppedNode->col, poppedNode->square[poppedNode->row][poppedNode->col]);
+
+    return poppedNode;
+
+}
+
+/**
+ *  @brief Mixes the bits of a number, to seed the random orders.
+ *
+ *  @param x The number to mix.
+ *
+ *  @return Returns the mixed number.
+ *
+ */
+static unsigned long long mixBits(unsigned long long x){
+
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+
+    return x ^ (x >> 31);
+
+}
+
+/**
+ *  @brief Finds the order in which the numbers are checked for insertion in a cell.
+ *
+ *  The random order of a cell only depends on the seed, the restart and the cell, so it is the same
+ *  every time the search comes back to the cell. The least constraining order uses the random order to
+ *  break ties, and it does not look at the cell itself, so it is the same when the search backtracks to it.
+ *
+ *  @param solver A pointer to the solver.
+ *  @param row Row of the cell.
+ *  @param col Column of the cell.
+ *
+ *  @return Returns NULL for the ascending order, else the array with the order of the numbers.
+ *
+ */
+static int *orderValues(SOLVER *solver, int row, int col){
+
+    int size = solver->size;
+    int *values = solver->values;
+    int *counts = solver->values + size; //  Number of empty cells in the same row and column where each number is possible.
+
+    if(solver->config.order == ORDER_ASCENDING) return NULL;
+
+    //  Shuffles the numbers with a random generator seeded for this cell.
+    unsigned long long state = mixBits(((unsigned long long)solver->config.seed << 32) ^ ((unsigned long long)solver->restarts << 20) ^ (unsigned long long)(row*size + col));
+
+    for(int i=0; i<size; i++) values[i] = i + 1;
+
+    for(int i=size-1; i>0; i--){
+
+        state = mixBits(state);
+        int j = (int)(state % (unsigned long long)(i + 1));
+        int temp = values[i];
+        values[i] = values[j];
+        values[j] = temp;
+
+    }
+
+    if(solver->config.order == ORDER_RANDOM) return values;
+
+    //  Marks the numbers used in each column and each row.
+    char *colUsed = solver->used;
+    char *rowUsed = solver->used + size*(size + 1);
+
+    memset(solver->used, 0, 2*size*(size + 1));
+
+    for(int i=0; i<size; i++){
+
+        for(int j=0; j<size; j++){
+
+            int value = abs(solver->square[i][j]);
+
+            if(value == 0 || (i == row && j == col)) continue;
+
+            colUsed[j*(size + 1) + value] = 1;
+            rowUsed[i*(size + 1) + value] = 1;
+
+        }
+
+    }
+
+    for(int v=1; v<=size; v++) counts[v - 1] = 0;
+
+    for(int j=0; j<size; j++){
+
+        if(j != col && solver->square[row][j] == 0){
+
+            for(int v=1; v<=size; v++) if(colUsed[j*(size + 1) + v] == 0 && rowUsed[row*(size + 1) + v] == 0) counts[v - 1]++;
+
+        }
+
+        if(j != row && solver->square[j][col] == 0){
+
+            for(int v=1; v<=size; v++) if(rowUsed[j*(size + 1) + v] == 0 && colUsed[col*(size + 1) + v] == 0) counts[v - 1]++;
+
+        }
+
+    }
+
+    //  Sorts the numbers by the number of options they take away, keeping the random order for ties.
+    for(int i=1; i<size; i++){
+
+        int value = values[i];
+        int j = i - 1;
+
+        while(j >= 0 && counts[values[j] - 1] > counts[value - 1]){
+
+            values[j + 1] = values[j];
+            j--;
+
+        }
+
+        values[j + 1] = value;
+
+    }
+
+    return values;
+
+}
+
+/**
+ *  @brief Finds the position of a number in the order of the numbers of a cell.
+ *
+ *  @param solver A pointer to the solver.
+ *  @param row Row of the cell.
+ *  @param col Column of the cell.
+ *  @param value The number.
+ *
+ *  @return Returns the position of the number, starting from 1.
+ *
+ */
+static int orderPosition(SOLVER *solver, int row, int col, int value){
+
+    int *values = orderValues(solver, row, col);
+
+    if(values == NULL) return value;
+
+    for(int i=0; i<solver->size; i++){
+
+        if(values[i] == value) return i + 1;
+
+    }
+
+    return solver->size + 1;
+
+}
+
+/**
+ *  @brief Finds the next cell of the search with the cell selection of the solver.
+ *
+ *  The cell only depends on the Latin Square, so a node always branches on the same cell.
+ *
+ *  @param solver A pointer to the solver.
+ *
+ *  @return Returns true if an empty cell was found, else it returns false.
+ *
+ */
+static bool selectCell(SOLVER *solver){
+
+    if(solver->config.cells == CELLS_FEWEST) return findFewestCell(solver->square, solver->size, solver->used, &solver->row, &solver->col);
+
+    return findEmptyCell(solver->square, solver->size, &solver->row, &solver->col);
+
+}
+
+/**
+ *  @brief Moves the search past the cell it is backtracking at, if that cell became a clue.
+ *
+ *  If the numbers before the clue were already checked in that cell, the search continues
+ *  with the clue in the cell from the next empty cell, else nothing is left to try in that cell.
+ *
+ *  @param solver A pointer to the solver.
+ *
+ */
+static void skipClueCell(SOLVER *solver){
+
+    int clue = -solver->clues[solver->row][solver->col];
+
+    if(clue == 0) return;
+
+    if(orderPosition(solver, solver->row, solver->col, clue) < solver->prevNum){
+
+        solver->prevNum = solver->size + 1;
+
+    }
+    else{
+
+        solver->prevNum = 1;
+        if(selectCell(solver) == false) solver->status = SOLVER_SOLVED;
+
+    }
+
+}
+
+/**
+ *  @brief Moves the search back to the cell of a popped node.
+ *
+ *  The Latin Square is restored from the node and the search continues with the numbers after the
+ *  one the node inserted.
+ *
+ *  @param solver A pointer to the solver.
+ *  @param poppedNode The popped node, it is freed.
+ *
+ */
+static void resumeFromNode(SOLVER *solver, NODE *poppedNode){
+
+    int prevNum = poppedNode->square[poppedNode->row][poppedNode->col]; //  Gets the previously inserted number so the search can start from there.
+
+    restoreSquare(solver, poppedNode);
+    solver->row = poppedNode->row; //  Row of the previously inserted cell.
+    solver->col = poppedNode->col; //  Column of the previously inserted cell.
+    solver->prevNum = orderPosition(solver, solver->row, solver->col, prevNum) + 1;
+
+    freeNode(poppedNode, solver->size);
+    skipClueCell(solver);
+
+}
+
+/**
+ *  @brief Starts the search of the solver over from its clues.
+ *
+ *  @param solver A pointer to the solver.
+ *
+ */
+static void resetSolver(SOLVER *solver){
+
+    while(isEmpty(solver->stack) == false) freeNode(pop(solver->stack), solver->size);
+
+    if(solver->trace != NULL) traceRecord(solver->trace, solver->steps, TRACE_RESTART, 0, 0, 0);
+
+    for(int i=0; i<solver->size; i++){
+
+        for(int j=0; j<solver->size; j++){
+
+            solver->square[i][j] = solver->clues[i][j];
+            solver->decisionAt[i][j] = 0;
+
+        }
+
+    }
+
+    solver->stale = false;
+    solver->checkRoot = true;
+    solver->propDepth = -1;
+    solver->prevNum = 1;
+
+    if(selectCell(solver) == true) solver->status = SOLVER_RUNNING;
+    else solver->status = SOLVER_SOLVED;
+
+}
+
+/**
+ *  @brief Finds the i-th number of the Luby sequence 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, ...
+ *
+ *  @param i The position in the sequence, starting from 1.
+ *
+ *  @return Returns the number of the sequence.
+ *
+ */
+static int luby(int i){
+
+    int k = 1;
+
+    while((1 << k) - 1 < i) k++;
+
+    if(i == (1 << k) - 1) return 1 << (k - 1);
+
+    return luby(i - (1 << (k - 1)) + 1);
+
+}
+
+/**
+ *  @brief Sets the step budget of the search before the next restart.
+ *
+ *  @param solver A pointer to the solver.
+ *
+ */
+static void setBudget(SOLVER *solver){
+
+    double budget = solver->config.restartBase;
+
+    if(solver->config.restart == RESTART_LUBY) budget *= luby(solver->restarts + 1);
+    else if(solver->config.restart == RESTART_GEOMETRIC) budget *= pow(1.5, solver->restarts);
+
+    solver->budget = (budget < INT_MAX) ? (int)budget : INT_MAX;
+
+}
+
+/**
+ *  @brief Abandons the search and restarts it from the clues with a different random order.
+ *
+ *  @param solver A pointer to the solver.
+ *
+ */
+static void restartSearch(SOLVER *solver){
+
+    solver->restarts++;
+    if(solver->config.verbose) printf("RESTART %d: STEP %d\n", solver->restarts, solver->steps);
+    resetSolver(solver);
+    setBudget(solver);
+
+}
+
+/**
+ *  @brief Sets the default configuration of a solver.
+ *
+ *  The default solver fills the first empty cell, checks the numbers in ascending order, never restarts, propagates the clues
+ *  once before the search and displays every step.
+ *
+ *  @param config Pointer to the configuration.
+ *
+ */
+void defaultConfig(SOLVER_CONFIG *config){
+
+    config->cells = CELLS_FIRST_EMPTY;
+    config->order = ORDER_ASCENDING;
+    config->seed = 0;
+    config->restart = RESTART_NONE;
+    config->restartBase = 100;
+    config->propagation = PROPAGATION_ROOT;
+    config->kernels = true;
+    config->traceFile = NULL;
+    config->verbose = true;
+
+}
+
+/**
+ *  @brief Initializes a new solver for a Latin Square.
+ *
+ *  The solver keeps its own copy of the Latin Square, the caller's array is not changed.
+ *
+ *  @param square 2D array representing the Latin Square.
+ *  @param size The size of the square array.
+ *  @param config Pointer to the configuration of the solver, NULL for the default configuration.
+ *
+ *  @return Returns a pointer to the solver.
+ *
+ */
+SOLVER *initSolver(int **square, int size, const SOLVER_CONFIG *config){
+
+    SOLVER *solver = (SOLVER *)malloc(sizeof(SOLVER));
+
+    if(solver == NULL){
+
+        printf("Error: Failed to allocate memory for the solver.\n");
+        exit(-1);
+
+    }
+
+    solver->size = size;
+    solver->square = allocSquare(size);
+    solver->clues = allocSquare(size);
+    solver->decisionAt = allocSquare(size);
+    solver->stack = initStack();
+    solver->values = (int *)malloc(2*size*sizeof(int));
+    solver->used = (char *)malloc(2*size*(size + 1));
+
+    if(solver->values == NULL || solver->used == NULL){
+
+        printf("Error: Failed to allocate memory for the solver.\n");
+        exit(-1);
+
+    }
+
+    if(config != NULL) solver->config = *config;
+    else defaultConfig(&solver->config);
+
+    solver->propagator = (solver->config.propagation == PROPAGATION_NONE) ? NULL : initPropagator(size);
+    solver->trace = (solver->config.traceFile == NULL) ? NULL : openTrace(solver->config.traceFile, square, size);
+    solver->checkRoot = true;
+    solver->propDepth = -1;
+    solver->pruneCount = 0;
+    solver->stale = false;
+    solver->restarts = 0;
+    solver->steps = 0;
+    solver->pushCount = 0;
+    solver->popCount = 0;
+
+    for(int i=0; i<size; i++){
+
+        for(int j=0; j<size; j++){
+
+            solver->square[i][j] = square[i][j];
+            if(square[i][j] < 0) solver->clues[i][j] = square[i][j];
+
+        }
+
+    }
+
+    solver->prevNum = 1;
+    solver->row = 0;
+    solver->col = 0;
+    setBudget(solver);
+
+    if(selectCell(solver) == true) solver->status = SOLVER_RUNNING; //  Finds the first cell of the search.
+    else solver->status = SOLVER_SOLVED;
+
+    return solver;
+
+}
+
+/**
+ *  @brief Propagates the clues of a solver, to reject a Latin Square whose clues are already unsolvable.
+ *
+ *  If the search is at its root and the Latin Square only has its clues, the domains of the
+ *  propagator belong to the root, so the first push only propagates its own number.
+ *
+ *  @param solver A pointer to the solver.
+ *
+ *  @return Returns false and sets the status to SOLVER_UNSOLVABLE if the clues are unsolvable, else true.
+ *
+ */
+bool propagateClues(SOLVER *solver){
+
+    int size = solver->size;
+
+    solver->checkRoot = false;
+    solver->propDepth = -1;
+
+    if(solver->propagator == NULL) return true;
+
+    if(propagate(solver->propagator, solver->clues) == false){
+
+        solver->status = SOLVER_UNSOLVABLE;
+        return false;
+
+    }
+
+    if(solver->stack->size > 0) return true;
+
+    for(int i=0; i<size; i++){
+
+        for(int j=0; j<size; j++){
+
+            if(solver->square[i][j] != solver->clues[i][j]) return true; //  The domains do not have the numbers that are not clues.
+
+        }
+
+    }
+
+    solver->propDepth = 0;
+
+    return true;
+
+}
+
+/**
+ *  @brief Runs the backtracking search of a solver.
+ *
+ *  This function solves a Latin Square using a backtracking algorithm and a stack. First it searches for an empty cell.
+ *  Then it checks if there is a number that can be inserted in that cell and it does not break the rules of the game.
+ *  If there is a valid number it is inserted in the Latin Square and pushed in the stack. If there is not a valid number the
+ *  previous state of the Latin Square is popped from the stack and a new number will be found.
+ *  If no number can be inserted in any cell then the Latin Square is unsolvable.
+ *
+ *  @param solver A pointer to the solver.
+ *  @param maxSteps The number of steps after which the search stops, 0 for no limit.
+ *
+ *  @return Returns the status of the solver, SOLVER_RUNNING if the search stopped after maxSteps.
+ *
+ */
+SOLVER_STATUS runSolver(SOLVER *solver, int maxSteps){
+
+    int size = solver->size;
+    int **square = solver->square;
+    STACK *stack = solver->stack;
+    int stepsTaken = 0; //  Counter for the steps of this run.
+
+    while(solver->status == SOLVER_RUNNING){
+
+        if(maxSteps > 0 && stepsTaken == maxSteps) break;
+
+        if(solver->checkRoot == true && propagateClues(solver) == false){ //  Rejects the Latin Square before the search if its clues are already unsolvable.
+
+            if(solver->config.verbose){
+
+                displayLatinSquare(size,square);
+                printf("THE LATIN SQUARE IS UNSOLVABLE!!\n");
+
+            }
+
+            break;
+
+        }
+
+        stepsTaken++;
+        solver->steps++;
+
+        if(solver->config.restart != RESTART_NONE){
+
+            if(solver->budget == 0) restartSearch(solver);
+            solver->budget--;
+
+        }
+
+        int row = solver->row;
+        int col = solver->col;
+        int validNum; //  Variable to store the valid number that will be inserted in the empty cell.
+        bool numberExists = false; //  Boolean to check if there is a valid number that can be inserted.
+        int *values = orderValues(solver,row,col); //  Order of the numbers for this cell, NULL for ascending order.
+        char *domain = NULL; //  Numbers of the cell that the propagation did not rule out, NULL if the domains are out of date.
+
+        if(solver->config.propagation == PROPAGATION_NODES && solver->propDepth == stack->size) domain = solver->propagator->domain + (row*size + col)*(size + 1);
+
+        for(int p=solver->prevNum; p<=size; p++){ //  This for loop checks if there is a valid number that can be inserted in the current empty cell.
+
+            int i = (values == NULL) ? p : values[p - 1]; //  The number that is checked.
+            bool found = true; //  Boolean to check if a valid number was found.
+
+            if(domain != NULL && domain[i] == 0) continue; //  No solution has the number in this cell.
+
+            for(int j=0; j<size; j++){ //  This for loop checks if the number can be inserted in the current empty cell.
+
+                if(abs(square[j][col]) == i || abs(square[row][j]) == i){ //  Checks if the number is already in the same column or row.
+
+                    found = false; //  Indicates that the number checked was not valid.
+                    break;
+
+                }
+
+            }
+
+            if(found == true){
+
+                validNum = i;
+                numberExists = true;
+                break;
+
+            }
+
+        }
+
+        if(numberExists == true){ //  A valid number was found, regular push.
+
+            solver->pushCount++;
+            if(solver->config.verbose) printf("PUSH: STEP %d\n", solver->steps);
+            square[row][col] = validNum; //  Updates the empty cell.
+            push(stack,square,size,row,col);
+            if(solver->trace != NULL) traceRecord(solver->trace, solver->steps, TRACE_PUSH, row, col, validNum);
+            solver->decisionAt[row][col] = stack->size;
+            selectCell(solver); //  Finds the next cell of the search.
+            if(solver->config.verbose) displayLatinSquare(size,square);
+            if(isSolved(square,size) == true) solver->status = SOLVER_SOLVED;
+            solver->prevNum = 1; //  No backtrack case so start checking from the first number of the order.
+
+            if(solver->config.propagation == PROPAGATION_NODES && solver->status == SOLVER_RUNNING){
+
+                bool consistent;
+
+                //  Only the new number is propagated if the domains belong to the previous decision, else they are built from scratch.
+                if(solver->propDepth == stack->size - 1) consistent = assignCell(solver->propagator, row, col, validNum);
+                else consistent = propagate(solver->propagator, square);
+
+                solver->propDepth = stack->size;
+
+                if(consistent == false){
+
+                    solver->pruneCount++;
+                    solver->prevNum = size + 1; //  Nothing is checked in the next cell, so the next step backtracks.
+
+                }
+
+            }
+
+        }
+        else{ //  A valid number was not found, backtrack case.
+
+            if(stack->size == 0){ //  If there are no stages to backtrack to then there is no solution.
+
+                if(solver->stale == true){ //  Clues were removed since the search started, so it is only complete if it starts over.
+
+                    if(solver->config.verbose) printf("RESTARTING THE SEARCH FROM THE CLUES\n");
+                    resetSolver(solver);
+                    continue;
+
+                }
+
+                if(solver->config.verbose){
+
+                    if(solver->steps == 1) displayLatinSquare(size,square);
+                    printf("THE LATIN SQUARE IS UNSOLVABLE!!\n");
+
+                }
+
+                solver->status = SOLVER_UNSOLVABLE;
+                break;
+
+            }
+
+            if(solver->config.verbose) printf("POP: STEP %d\n", solver->steps);
+            resumeFromNode(solver, popDecision(solver)); //  Pops the previous state of the Latin Square from the stack.
+            if(solver->config.verbose) displayLatinSquare(size,square);
+
+        }
+
+    }
+
+    return solver->status;
+
+}
+
+/**
+ *  @brief Invalidates a filled cell that conflicts with a new clue.
+ *
+ *  If a decision in the stack filled the cell, the earliest invalidated stack depth is updated,
+ *  else the number is simply removed from the cell.
+ *
+ *  @param solver A pointer to the solver.
+ *  @param row Row of the conflicting cell.
+ *  @param col Column of the conflicting cell.
+ *  @param earliest Pointer to the earliest invalidated stack depth, 0 if none.
+ *  @param cleared Pointer to a boolean that is set if the cell was emptied.
+ *
+ */
+static void invalidateCell(SOLVER *solver, int row, int col, int *earliest, bool *cleared){
+
+    int depth = solver->decisionAt[row][col];
+
+    if(depth != 0){
+
+        if(*earliest == 0 || depth < *earliest) *earliest = depth;
+
+    }
+    else{
+
+        setCell(solver, row, col, 0);
+        *cleared = true;
+
+    }
+
+}
+
+/**
+ *  @brief Applies clue edits to a solver and moves its search back only as far as needed.
+ *
+ *  Adding a clue invalidates the decisions that inserted a conflicting number in its row, its column
+ *  or its cell. The stack is popped back to the earliest of those decisions and the search continues
+ *  from there. If the current Latin Square already agrees with the new clues nothing is popped, so a
+ *  solved Latin Square stays solved after O(edits) work. Removing a clue never invalidates a decision,
+ *  but the part of the search that was already explored may now hide solutions, so the solver starts
+ *  over from the clues before it reports the Latin Square as unsolvable.
+ *
+ *  @param solver A pointer to the solver.
+ *  @param edits Array with the clue edits.
+ *  @param count The number of clue edits.
+ *
+ *  @return Returns the stack depth the search continues from, or -1 if the edits are not valid
+ *  (the solver is then left unchanged).
+ *
+ */
+int applyClueEdits(SOLVER *solver, CLUE_EDIT *edits, int count){
+
+    int size = solver->size;
+    int **square = solver->square;
+    int **clues = solver->clues;
+    int earliest = 0; //  Earliest stack depth that the edits invalidate, 0 if none.
+    bool cleared = false; //  Boolean to check if a filled cell was emptied.
+    bool removed = false; //  Boolean to check if a clue was removed or replaced.
+
+    for(int k=0; k<count; k++){
+
+        if(edits[k].row < 0 || edits[k].row >= size || edits[k].col < 0 || edits[k].col >= size || edits[k].value < 0 || edits[k].value > size){
+
+            printf("Error: Invalid clue edit (%d, %d) = %d.\n", edits[k].row+1, edits[k].col+1, edits[k].value);
+            return -1;
+
+        }
+
+    }
+
+    if(count == 0) return solver->stack->size;
+
+    int *oldClues = (int *)malloc(count*sizeof(int));
+
+    if(oldClues == NULL){
+
+        printf("Error: Failed to allocate memory for the clue edits.\n");
+        exit(-1);
+
+    }
+
+    //  Updates the clues, remembering the old ones in case the edits have to be undone.
+    for(int k=0; k<count; k++){
+
+        oldClues[k] = clues[edits[k].row][edits[k].col];
+        clues[edits[k].row][edits[k].col] = -edits[k].value;
+
+    }
+
+    //  Checks that the new clues do not duplicate any other clue in the same row or column.
+    for(int k=0; k<count; k++){
+
+        int r = edits[k].row;
+        int c = edits[k].col;
+
+        for(int j=0; j<size && clues[r][c] != 0; j++){
+
+            if((j != c && clues[r][j] == clues[r][c]) || (j != r && clues[j][c] == clues[r][c])){
+
+                printf("Error: Clue edit (%d, %d) = %d duplicates another clue.\n", r+1, c+1, edits[k].value);
+                for(int m=count-1; m>=0; m--) clues[edits[m].row][edits[m].col] = oldClues[m];
+                free(oldClues);
+                return -1;
+
+            }
+
+        }
+
+    }
+
+    if(solver->trace != NULL){
+
+        for(int k=0; k<count; k++) traceRecord(solver->trace, solver->steps, TRACE_CLUE, edits[k].row, edits[k].col, edits[k].value);
+
+    }
+
+    //  Removed clues keep their number only while the Latin Square is solved.
+    for(int k=0; k<count; k++){
+
+        int r = edits[k].row;
+        int c = edits[k].col;
+
+        if(oldClues[k] == 0 || oldClues[k] == clues[r][c]) continue;
+
+        removed = true;
+        if(square[r][c] == oldClues[k]) setCell(solver, r, c, (solver->status == SOLVER_SOLVED) ? -oldClues[k] : 0);
+
+    }
+
+    free(oldClues);
+
+    //  Finds the decisions that conflict with the added clues.
+    for(int k=0; k<count; k++){
+
+        int r = edits[k].row;
+        int c = edits[k].col;
+        int value = edits[k].value;
+
+        if(value == 0 || clues[r][c] != -value) continue; //  Removed, or replaced by a later edit of the same cell.
+        if(abs(square[r][c]) == value) continue; //  The Latin Square already agrees with the clue.
+
+        if(square[r][c] > 0) invalidateCell(solver, r, c, &earliest, &cleared); //  The cell has a different number.
+
+        for(int j=0; j<size; j++){
+
+            if(j != c && square[r][j] == value) invalidateCell(solver, r, j, &earliest, &cleared);
+            if(j != r && square[j][c] == value) invalidateCell(solver, j, c, &earliest, &cleared);
+
+        }
+
+    }
+
+    if(removed == true || solver->config.order == ORDER_LCV) solver->stale = true; //  The least constraining order of a cell can change with the clues.
+    solver->checkRoot = true;
+    solver->propDepth = -1;
+
+    if(solver->status == SOLVER_UNSOLVABLE && removed == true){ //  Removing a clue can make the Latin Square solvable.
+
+        resetSolver(solver);
+        return 0;
+
+    }
+
+    if(earliest != 0 && solver->status != SOLVER_UNSOLVABLE){ //  Backtracks to the earliest invalidated decision.
+
+        NODE *poppedNode = NULL;
+
+        while(solver->stack->size >= earliest){
+
+            if(poppedNode != NULL) freeNode(poppedNode, size);
+            poppedNode = popDecision(solver);
+
+        }
+
+        solver->status = SOLVER_RUNNING;
+        resumeFromNode(solver, poppedNode);
+
+        return solver->stack->size;
+
+    }
+
+    //  No decision was invalidated, so the clues are inserted in the current Latin Square.
+    for(int k=0; k<count; k++){
+
+        int r = edits[k].row;
+        int c = edits[k].col;
+
+        if(clues[r][c] != 0 && square[r][c] != clues[r][c]) setCell(solver, r, c, clues[r][c]);
+
+    }
+
+    if(solver->status == SOLVER_SOLVED && cleared == true){
+
+        selectCell(solver);
+        solver->prevNum = 1;
+        solver->status = SOLVER_RUNNING;
+
+    }
+    else if(solver->status == SOLVER_RUNNING){
+
+        if(solver->prevNum == 1 && square[solver->row][solver->col] != 0){ //  The cell the search was at got filled.
+
+            if(selectCell(solver) == false) solver->status = SOLVER_SOLVED;
+
+        }
+        else{ //  The cell the search was backtracking at may have become a clue.
+
+            skipClueCell(solver);
+
+        }
+
+    }
+
+    return solver->stack->size;
+
+}
+
+/**
+ *  @brief Frees all memory that was allocated for a solver.
+ *
+ *  @param solver A pointer to the solver to be freed.
+ *
+ */
+void freeSolver(SOLVER *solver){
+
+    if(solver == NULL) return;
+
+    freeSquare(solver->square, solver->size);
+    freeSquare(solver->clues, solver->size);
+    freeSquare(solver->decisionAt, solver->size);
+    freeStack(solver->stack, solver->size);
+    freePropagator(solver->propagator);
+    closeTrace(solver->trace);
+    free(solver->values);
+    free(solver->used);
+    free(solver);
+
+}
@@ -0,0 +1,169 @@
+/**
+ *  @mainpage Latin Square
+ *  @file solver.h
+ *  @brief Header file for the backtracking solver of the Latin Square.
+ *
+ *  This program contains the solver state and the function declarations for
+ *  solving a Latin Square, stepping the search and re-solving it after clue edits.
+ *  The solver can select the cell with the fewest valid numbers next, check the
+ *  numbers of a cell in different orders, restart the search with a different random
+ *  order after a growing step budget, and propagate the all-different constraints of
+ *  the rows and columns to prune the search.
+ *
+ *  @author Christos Michael (ID: 1135102 / UC1070456)
+ *          Leandros Antoniades (ID: 1119296 / UC1069738)
+ *
+ *  @bug No known bugs.
+ *
+ */
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include<stdbool.h>
+#include"stack.h"
+#include"propagation.h"
+#include"trace.h"
+
+/**
+ *  @brief The state the search of a solver is in.
+ *
+ */
+typedef enum{
+
+    SOLVER_RUNNING,
+    SOLVER_SOLVED,
+    SOLVER_UNSOLVABLE
+
+}SOLVER_STATUS;
+
+/**
+ *  @brief The rule that selects the next cell of the search.
+ *
+ */
+typedef enum{
+
+    CELLS_FIRST_EMPTY, //  The first empty cell, row by row.
+    CELLS_FEWEST //  The empty cell with the fewest valid numbers (minimum remaining values).
+
+}CELL_SELECTION;
+
+/**
+ *  @brief The order in which the numbers are checked for insertion in a cell.
+ *
+ */
+typedef enum{
+
+    ORDER_ASCENDING, //  1, 2, ..., size.
+    ORDER_LCV, //  Least constraining number first, the number that is possible in the fewest empty cells of the same row and column.
+    ORDER_RANDOM //  Random order for each cell, that depends on the seed and the restart.
+
+}VALUE_ORDER;
+
+/**
+ *  @brief The strategy for restarting a search that runs for too long.
+ *
+ */
+typedef enum{
+
+    RESTART_NONE,
+    RESTART_LUBY, //  Budgets of base*1, base*1, base*2, base*1, base*1, base*2, base*4, ... steps.
+    RESTART_GEOMETRIC //  Budgets of base, base*1.5, base*1.5^2, ... steps.
+
+}RESTART_STRATEGY;
+
+/**
+ *  @brief Where the all-different propagation of the rows and columns runs.
+ *
+ */
+typedef enum{
+
+    PROPAGATION_NONE,
+    PROPAGATION_ROOT, //  Once on the clues, to reject unsolvable Latin Squares before the search.
+    PROPAGATION_NODES //  Also after every push, to backtrack as soon as the Latin Square becomes unsolvable and skip the numbers that were ruled out.
+
+}PROPAGATION;
+
+/**
+ *  @brief Represents the configuration of a solver.
+ *
+ */
+typedef struct{
+
+    CELL_SELECTION cells;
+    VALUE_ORDER order;
+    unsigned int seed; //  Seed of the random orders.
+    RESTART_STRATEGY restart;
+    int restartBase; //  Step budget of the first search before a restart.
+    PROPAGATION propagation;
+    bool kernels; //  True if a kernel specialized for the order may solve the Latin Square instead of the generic search.
+    const char *traceFile; //  Name of the binary trace file of the steps, NULL for no trace.
+    bool verbose; //  True if every step of the search is displayed.
+
+}SOLVER_CONFIG;
+
+/**
+ *  @brief Represents the state of a backtracking search.
+ *
+ *  The solver owns its own copy of the Latin Square and its own stack, so a search
+ *  can be stopped after a number of steps and resumed later, or resumed after the
+ *  clues were edited.
+ *
+ */
+typedef struct{
+
+    int size;
+    int **square; //  Current state of the Latin Square.
+    int **clues; //  The clues of the Latin Square (negative values), 0 for the cells that are not clues.
+    int **decisionAt; //  Stack depth of the decision that filled each cell, 0 if no decision filled it.
+    STACK *stack;
+    int row; //  Row of the cell the search is at.
+    int col; //  Column of the cell the search is at.
+    int prevNum; //  Position (from 1) in the order of the numbers of the cell, of the number the search will check next for insertion.
+    bool stale; //  True if clues were removed, so the explored part of the search may hide solutions.
+    SOLVER_CONFIG config;
+    int *values; //  Order of the numbers for the cell the search is at.
+    char *used; //  Marks of the numbers used in each row and column, for the least constraining order and the fewest valid numbers cell selection.
+    int restarts; //  Number of restarts of the search.
+    int budget; //  Steps left before the next restart.
+    PROPAGATOR *propagator; //  NULL if there is no propagation.
+    bool checkRoot; //  True if the clues have to be propagated before the next step.
+    int propDepth; //  Stack depth that the domains of the propagator belong to, -1 if they are out of date.
+    int pruneCount; //  Number of pushes after which the propagation found the Latin Square unsolvable.
+    TRACE *trace; //  NULL if the steps are not traced.
+    int steps;
+    int pushCount;
+    int popCount;
+    SOLVER_STATUS status;
+
+}SOLVER;
+
+/**
+ *  @brief Represents an edit of a clue.
+ *
+ *  A value between 1 and size adds the clue at that cell, a value of 0 removes the clue of that cell.
+ *  The row and the column start from 0.
+ *
+ */
+typedef struct{
+
+    int row;
+    int col;
+    int value;
+
+}CLUE_EDIT;
+
+//  Latin Square function declarations.
+bool isSolved(int **square, int size);
+void displayLatinSquare(int size, int **square);
+bool findEmptyCell(int **square, int size, int *row, int *col);
+bool findFewestCell(int **square, int size, char *used, int *row, int *col);
+
+//  Solver function declarations.
+void defaultConfig(SOLVER_CONFIG *config);
+SOLVER *initSolver(int **square, int size, const SOLVER_CONFIG *config);
+bool propagateClues(SOLVER *solver);
+SOLVER_STATUS runSolver(SOLVER *solver, int maxSteps);
+int applyClueEdits(SOLVER *solver, CLUE_EDIT *edits, int count);
+void freeSolver(SOLVER *solver);
+
+#endif
@@ -0,0 +1,233 @@
+/**
+ *  @mainpage Latin Square
+ *  @file trace.c
+ *  @brief Source file for the binary step trace of the solver.
+ *
+ *  This program records the steps of a search as fixed-size binary records, which are
+ *  buffered and written to the trace file in large blocks, and reads a trace file back.
+ *
+ *  @author Christos Michael (ID: 1135102 / UC1070456)
+ *          Leandros Antoniades (ID: 1119296 / UC1069738)
+ *
+ *  @bug No known bugs.
+ *
+ */
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include"trace.h"
+
+/**
+ *  @brief Writes the buffered records to the trace file.
+ *
+ *  @param trace A pointer to the trace.
+ *
+ */
+static void flushTrace(TRACE *trace){
+
+    if(trace->count > 0 && fwrite(trace->buffer, sizeof(TRACE_RECORD), trace->count, trace->file) != (size_t)trace->count){
+
+        printf("Error: Failed to write the trace file.\n");
+        exit(-1);
+
+    }
+
+    trace->count = 0;
+
+}
+
+/**
+ *  @brief Opens a new trace file and writes its header.
+ *
+ *  @param name The name of the trace file.
+ *  @param square 2D array representing the starting Latin Square.
+ *  @param size The size of the Latin Square.
+ *
+ *  @return Returns a pointer to the trace.
+ *
+ */
+TRACE *openTrace(const char *name, int **square, int size){
+
+    if(size > TRACE_MAX_SIZE){
+
+        printf("Error: Latin Squares bigger than %d cannot be traced.\n", TRACE_MAX_SIZE);
+        exit(-1);
+
+    }
+
+    TRACE *trace = (TRACE *)malloc(sizeof(TRACE));
+
+    if(trace == NULL){
+
+        printf("Error: Failed to allocate memory for the trace.\n");
+        exit(-1);
+
+    }
+
+    trace->buffer = (TRACE_RECORD *)malloc(TRACE_BLOCK*sizeof(TRACE_RECORD));
+    trace->file = fopen(name, "wb");
+    trace->count = 0;
+    trace->records = 0;
+
+    if(trace->buffer == NULL){
+
+        printf("Error: Failed to allocate memory for the trace.\n");
+        exit(-1);
+
+    }
+
+    if(trace->file == NULL){
+
+        printf("Error: Failed to open the trace file.\n");
+        exit(-1);
+
+    }
+
+    int32_t header[2] = {TRACE_VERSION, size};
+
+    fwrite("LSQT", 1, 4, trace->file);
+    fwrite(header, sizeof(int32_t), 2, trace->file);
+
+    for(int i=0; i<size; i++){
+
+        for(int j=0; j<size; j++){
+
+            int32_t value = square[i][j];
+            fwrite(&value, sizeof(int32_t), 1, trace->file);
+
+        }
+
+    }
+
+    return trace;
+
+}
+
+/**
+ *  @brief Records one step of the search in the trace.
+ *
+ *  @param trace A pointer to the trace.
+ *  @param step The step of the search.
+ *  @param op The operation of the step.
+ *  @param row Row of the cell of the step.
+ *  @param col Column of the cell of the step.
+ *  @param value The number of the step.
+ *
+ */
+void traceRecord(TRACE *trace, int step, TRACE_OP op, int row, int col, int value){
+
+    TRACE_RECORD *record = &trace->buffer[trace->count];
+
+    record->step = step;
+    record->op = (uint8_t)op;
+    record->row = (uint8_t)row;
+    record->col = (uint8_t)col;
+    record->value = (uint8_t)value;
+    trace->records++;
+
+    if(++trace->count == TRACE_BLOCK) flushTrace(trace);
+
+}
+
+/**
+ *  @brief Writes the remaining records and closes the trace.
+ *
+ *  @param trace A pointer to the trace to be closed.
+ *
+ */
+void closeTrace(TRACE *trace){
+
+    if(trace == NULL) return;
+
+    flushTrace(trace);
+    fclose(trace->file);
+    free(trace->buffer);
+    free(trace);
+
+}
+
+/**
+ *  @brief Reads the header of a trace file.
+ *
+ *  @param file Pointer to the trace file.
+ *  @param size Pointer to the size of the Latin Square.
+ *
+ *  @return Returns a 2D array with the starting Latin Square.
+ *
+ */
+int **readTraceHeader(FILE *file, int *size){
+
+    char magic[4];
+    int32_t header[2];
+
+    if(fread(magic, 1, 4, file) != 4 || memcmp(magic, "LSQT", 4) != 0 || fread(header, sizeof(int32_t), 2, file) != 2){
+
+        printf("Error: Not a trace file.\n");
+        exit(-1);
+
+    }
+
+    if(header[0] != TRACE_VERSION || header[1] < 1 || header[1] > TRACE_MAX_SIZE){
+
+        printf("Error: Unsupported trace file.\n");
+        exit(-1);
+
+    }
+
+    *size = header[1];
+
+    int **square = (int **)malloc(*size*sizeof(int *));
+
+    if(square == NULL){
+
+        printf("Error: Failed to allocate memory for the Latin Square.(rows)\n");
+        exit(-1);
+
+    }
+
+    for(int i=0; i<*size; i++){
+
+        square[i] = (int *)malloc(*size*sizeof(int));
+
+        if(square[i] == NULL){
+
+            printf("Error: Failed to allocate memory for the Latin Square.(columns)\n");
+            exit(-1);
+
+        }
+
+        for(int j=0; j<*size; j++){
+
+            int32_t value;
+
+            if(fread(&value, sizeof(int32_t), 1, file) != 1){
+
+                printf("Error: The trace file is cut short.\n");
+                exit(-1);
+
+            }
+
+            square[i][j] = value;
+
+        }
+
+    }
+
+    return square;
+
+}
+
+/**
+ *  @brief Reads the next block of records of a trace file.
+ *
+ *  @param file Pointer to the trace file, after its header.
+ *  @param records Array with room for TRACE_BLOCK records.
+ *
+ *  @return Returns the number of records that were read, 0 at the end of the file.
+ *
+ */
+int readTraceRecords(FILE *file, TRACE_RECORD *records){
+
+    return (int)fread(records, sizeof(TRACE_RECORD), TRACE_BLOCK, file);
+
+}
@@ -0,0 +1,82 @@
+/**
+ *  @mainpage Latin Square
+ *  @file trace.h
+ *  @brief Header file for the binary step trace of the solver.
+ *
+ *  This program contains the trace record and trace data structures and the function
+ *  declarations for recording the steps of a search in a binary file and reading them back.
+ *
+ *  A trace file starts with the magic "LSQT", the version and the size of the Latin Square
+ *  (as 32-bit integers) and the starting Latin Square (size*size 32-bit integers, clues are
+ *  negative). Then it has one fixed-size TRACE_RECORD for every step, in the byte order of
+ *  the machine that recorded it.
+ *
+ *  @author Christos Michael (ID: 1135102 / UC1070456)
+ *          Leandros Antoniades (ID: 1119296 / UC1069738)
+ *
+ *  @bug No known bugs.
+ *
+ */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include<stdio.h>
+#include<stdint.h>
+#include<stdbool.h>
+
+#define TRACE_VERSION 2
+#define TRACE_MAX_SIZE 255 //  Max Latin Square that can be traced, the row, column and number of a record are bytes.
+#define TRACE_BLOCK 65536 //  Number of records that are buffered before they are written to the file.
+
+/**
+ *  @brief The operation of a trace record.
+ *
+ */
+typedef enum{
+
+    TRACE_PUSH = 1, //  A number was inserted in a cell and pushed in the stack.
+    TRACE_POP = 2, //  The decision of a cell was popped from the stack.
+    TRACE_RESTART = 3, //  The search started over from the clues.
+    TRACE_CLUE = 4, //  A clue was edited, a number of 0 removes the clue.
+    TRACE_CELL = 5 //  The clue edits changed a cell outside of the search, the number is a clue if it is the clue of the cell, 0 empties it.
+
+}TRACE_OP;
+
+/**
+ *  @brief Represents one step of the search.
+ *
+ */
+typedef struct{
+
+    int32_t step;
+    uint8_t op;
+    uint8_t row;
+    uint8_t col;
+    uint8_t value;
+
+}TRACE_RECORD;
+
+/**
+ *  @brief Represents a trace that is recorded.
+ *
+ *  The records are kept in a buffer that is written to the file in blocks of TRACE_BLOCK
+ *  records and then reused.
+ *
+ */
+typedef struct{
+
+    FILE *file;
+    TRACE_RECORD *buffer;
+    int count; //  Number of records in the buffer.
+    long records; //  Number of records in the trace.
+
+}TRACE;
+
+//  Trace function declarations.
+TRACE *openTrace(const char *name, int **square, int size);
+void traceRecord(TRACE *trace, int step, TRACE_OP op, int row, int col, int value);
+void closeTrace(TRACE *trace);
+int **readTraceHeader(FILE *file, int *size);
+int readTraceRecords(FILE *file, TRACE_RECORD *records);
+
+#endif
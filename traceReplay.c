@@ -0,0 +1,406 @@
+/**
+ *  @mainpage Latin Square
+ *  @file traceReplay.c
+ *  @brief Offline replay of the binary step traces of the solver.
+ *
+ *  This program reads a trace file that was recorded with "./latinSolver --trace", rebuilds
+ *  the Latin Square at any step and displays it, and summarizes the search: the cells that
+ *  were pushed the most and how deep the stack was when the search backtracked.
+ *
+ *  @author Christos Michael (ID: 1135102 / UC1070456)
+ *          Leandros Antoniades (ID: 1119296 / UC1069738)
+ *
+ *  @bug No known bugs.
+ *
+ */
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include"solver.h"
+#include"trace.h"
+
+#define HOT_CELLS 10 //  Number of hot cells in the summary.
+
+/**
+ *  @brief Represents the Latin Square and the statistics of a trace while it is replayed.
+ *
+ */
+typedef struct{
+
+    int size;
+    int **square; //  Latin Square after the replayed records.
+    int **clues; //  Clues of the Latin Square, after the replayed clue edits.
+    int *cells; //  Stack of the cells (row*size + col) of the decisions.
+    int *decisionAt; //  Stack depth of the decision that filled each cell, 0 if no decision filled it.
+    int depth; //  Number of decisions in the stack.
+    long pushes;
+    long pops;
+    long restarts;
+    long clueEdits;
+    long *cellPushes; //  Number of pushes of each cell.
+    long *depthPops; //  Number of pops at each stack depth.
+    int maxDepth;
+    long backtracks; //  Number of runs of consecutive pops.
+    long longestBacktrack; //  Most consecutive pops.
+    long currentBacktrack; //  Consecutive pops so far.
+
+}REPLAY;
+
+/**
+ *  @brief Applies one record of the trace to the replay.
+ *
+ *  A push inserts the number in the cell. A pop restores the Latin Square like the solver does, so only
+ *  the clues, the decisions that are still in the stack and the popped decision keep their numbers. A
+ *  clue edit only changes the clues, the cells it changed outside of the search have their own records.
+ *
+ *  @param replay A pointer to the replay.
+ *  @param record The record.
+ *
+ *  @return Returns void.
+ *
+ */
+void applyRecord(REPLAY *replay, TRACE_RECORD *record){
+
+    int size = replay->size;
+    int cell = record->row*size + record->col;
+
+    if(record->row >= size || record->col >= size || record->value > size){
+
+        printf("Error: The trace file has an invalid record at step %d.\n", record->step);
+        exit(-1);
+
+    }
+
+    if(record->op != TRACE_POP && replay->currentBacktrack > 0){ //  A run of pops ended.
+
+        replay->backtracks++;
+        if(replay->currentBacktrack > replay->longestBacktrack) replay->longestBacktrack = replay->currentBacktrack;
+        replay->currentBacktrack = 0;
+
+    }
+
+    switch(record->op){
+
+        case TRACE_PUSH:
+
+            if(replay->depth == size*size){
+
+                printf("Error: The trace file pushes a full stack at step %d.\n", record->step);
+                exit(-1);
+
+            }
+
+            replay->square[record->row][record->col] = record->value;
+            replay->cells[replay->depth++] = cell;
+            replay->decisionAt[cell] = replay->depth;
+            if(replay->depth > replay->maxDepth) replay->maxDepth = replay->depth;
+            replay->cellPushes[cell]++;
+            replay->pushes++;
+            break;
+
+        case TRACE_POP:
+
+            if(replay->depth == 0){
+
+                printf("Error: The trace file pops an empty stack at step %d.\n", record->step);
+                exit(-1);
+
+            }
+
+            replay->depthPops[replay->depth]++;
+            replay->decisionAt[replay->cells[--replay->depth]] = 0;
+
+            for(int i=0; i<size; i++){
+
+                for(int j=0; j<size; j++){
+
+                    if(replay->clues[i][j] != 0) replay->square[i][j] = replay->clues[i][j];
+                    else if(i*size + j == cell) replay->square[i][j] = record->value;
+                    else if(replay->decisionAt[i*size + j] == 0) replay->square[i][j] = 0;
+
+                }
+
+            }
+
+            replay->currentBacktrack++;
+            replay->pops++;
+            break;
+
+        case TRACE_RESTART:
+
+            for(int i=0; i<size; i++){
+
+                for(int j=0; j<size; j++) replay->square[i][j] = replay->clues[i][j];
+
+            }
+
+            for(int k=0; k<size*size; k++) replay->decisionAt[k] = 0;
+
+            replay->depth = 0;
+            replay->restarts++;
+            break;
+
+        case TRACE_CLUE:
+
+            replay->clues[record->row][record->col] = -record->value;
+            replay->clueEdits++;
+            break;
+
+        case TRACE_CELL:
+
+            if(record->value != 0 && replay->clues[record->row][record->col] == -record->value) replay->square[record->row][record->col] = -record->value;
+            else replay->square[record->row][record->col] = record->value;
+            break;
+
+        default:
+
+            printf("Error: The trace file has an unknown operation at step %d.\n", record->step);
+            exit(-1);
+
+    }
+
+}
+
+/**
+ *  @brief Displays the summary of a replayed trace.
+ *
+ *  @param replay A pointer to the replay.
+ *
+ *  @return Returns void.
+ *
+ */
+void displaySummary(REPLAY *replay){
+
+    int size = replay->size;
+    long sumDepth = 0;
+
+    printf("PUSH NUM: %ld\n", replay->pushes);
+    printf("POP NUM: %ld\n", replay->pops);
+    printf("RESTARTS: %ld\n", replay->restarts);
+    printf("CLUE EDITS: %ld\n", replay->clueEdits);
+    printf("MAX DEPTH: %d\n", replay->maxDepth);
+
+    for(int d=1; d<=size*size; d++) sumDepth += d*replay->depthPops[d];
+
+    if(replay->pops > 0){
+
+        printf("AVERAGE POP DEPTH: %.2f\n", (double)sumDepth/replay->pops);
+        printf("BACKTRACKS: %ld (AVERAGE %.2f POPS, LONGEST %ld POPS)\n", replay->backtracks, (double)replay->pops/replay->backtracks, replay->longestBacktrack);
+        printf("POPS BY DEPTH:\n");
+
+        for(int d=1; d<=size*size; d++){
+
+            if(replay->depthPops[d] > 0) printf("  DEPTH %3d: %ld\n", d, replay->depthPops[d]);
+
+        }
+
+    }
+
+    //  Displays the pushes of every cell.
+    printf("PUSHES BY CELL:\n");
+
+    for(int i=0; i<size; i++){
+
+        for(int j=0; j<size; j++) printf("%9ld", replay->cellPushes[i*size + j]);
+
+        printf("\n");
+
+    }
+
+    //  Displays the cells with the most pushes, by selecting the biggest remaining one each time.
+    printf("HOT CELLS:\n");
+
+    char *listed = (char *)calloc(size*size, 1);
+
+    if(listed == NULL){
+
+        printf("Error: Failed to allocate memory for the summary.\n");
+        exit(-1);
+
+    }
+
+    for(int k=0; k<HOT_CELLS && k<size*size; k++){
+
+        int best = -1;
+
+        for(int cell=0; cell<size*size; cell++){
+
+            if(listed[cell] == 0 && replay->cellPushes[cell] > 0 && (best < 0 || replay->cellPushes[cell] > replay->cellPushes[best])) best = cell;
+
+        }
+
+        if(best < 0) break;
+
+        listed[best] = 1;
+        printf("  ROW %d COLUMN %d: %ld PUSHES\n", best/size + 1, best%size + 1, replay->cellPushes[best]);
+
+    }
+
+    free(listed);
+
+}
+
+/**
+ *  @brief This is the main function of the traceReplay program.
+ *
+ *  This function replays a trace file, displays the Latin Square at the requested step and
+ *  the summary of the search.
+ *
+ *  @param argc The number of arguments in the command line.
+ *  @param argv An array of strings containing the arguments in the command line.
+ *
+ *  @return Returns 0 if the program was completed successfully.
+ *
+ */
+int main(int argc, char *argv[]){
+
+    char *traceName = NULL; //  Name of the trace file.
+    long displayStep = -1; //  Step after which the Latin Square is displayed, -1 for none.
+    bool summary = false;
+
+    for(int i=1; i<argc; i++){
+
+        if(strcmp(argv[i], "--step") == 0 && i+1 < argc){
+
+            displayStep = atol(argv[++i]);
+
+        }
+        else if(strcmp(argv[i], "--summary") == 0){
+
+            summary = true;
+
+        }
+        else if(argv[i][0] != '-' && traceName == NULL){
+
+            traceName = argv[i];
+
+        }
+        else{
+
+            printf("Error: Invalid argument %s.\n", argv[i]);
+            printf("Usage: ./traceReplay [--step <step>] [--summary] <trace_file.bin>\n");
+            exit(-1);
+
+        }
+
+    }
+
+    if(traceName == NULL){
+
+        printf("Error: Not enought arguments.\n");
+        printf("Usage: ./traceReplay [--step <step>] [--summary] <trace_file.bin>\n");
+        exit(-1);
+
+    }
+
+    if(displayStep < 0) summary = true;
+
+    FILE *file = fopen(traceName, "rb");
+
+    if(file == NULL){
+
+        printf("Error: Failed to open the trace file.\n");
+        exit(-1);
+
+    }
+
+    REPLAY replay;
+    int size;
+
+    memset(&replay, 0, sizeof(REPLAY));
+    replay.square = readTraceHeader(file, &size);
+    replay.size = size;
+    replay.clues = (int **)malloc(size*sizeof(int *));
+    replay.cells = (int *)malloc(size*size*sizeof(int));
+    replay.decisionAt = (int *)calloc(size*size, sizeof(int));
+    replay.cellPushes = (long *)calloc(size*size, sizeof(long));
+    replay.depthPops = (long *)calloc(size*size + 1, sizeof(long));
+
+    if(replay.clues == NULL || replay.cells == NULL || replay.decisionAt == NULL || replay.cellPushes == NULL || replay.depthPops == NULL){
+
+        printf("Error: Failed to allocate memory for the replay.\n");
+        exit(-1);
+
+    }
+
+    //  The clues are the negative numbers of the starting Latin Square.
+    for(int i=0; i<size; i++){
+
+        replay.clues[i] = (int *)malloc(size*sizeof(int));
+
+        if(replay.clues[i] == NULL){
+
+            printf("Error: Failed to allocate memory for the replay.\n");
+            exit(-1);
+
+        }
+
+        for(int j=0; j<size; j++) replay.clues[i][j] = (replay.square[i][j] < 0) ? replay.square[i][j] : 0;
+
+    }
+
+    TRACE_RECORD *records = (TRACE_RECORD *)malloc(TRACE_BLOCK*sizeof(TRACE_RECORD));
+    int count;
+    bool displayed = false;
+
+    if(records == NULL){
+
+        printf("Error: Failed to allocate memory for the replay.\n");
+        exit(-1);
+
+    }
+
+    while((count = readTraceRecords(file, records)) > 0){
+
+        for(int k=0; k<count; k++){
+
+            if(displayed == false && displayStep >= 0 && records[k].step > displayStep){
+
+                printf("STEP %ld:\n", displayStep);
+                displayLatinSquare(size, replay.square);
+                displayed = true;
+
+            }
+
+            applyRecord(&replay, &records[k]);
+
+        }
+
+    }
+
+    if(replay.currentBacktrack > 0){ //  The trace ended with a run of pops.
+
+        replay.backtracks++;
+        if(replay.currentBacktrack > replay.longestBacktrack) replay.longestBacktrack = replay.currentBacktrack;
+
+    }
+
+    if(displayed == false && displayStep >= 0){ //  The step is after the end of the trace.
+
+        printf("STEP %ld (END OF TRACE):\n", displayStep);
+        displayLatinSquare(size, replay.square);
+
+    }
+
+    if(summary == true) displaySummary(&replay);
+
+    //  Frees the allocated memory.
+    for(int i=0; i<size; i++){
+
+        free(replay.square[i]);
+        free(replay.clues[i]);
+
+    }
+
+    free(replay.square);
+    free(replay.clues);
+    free(replay.cells);
+    free(replay.decisionAt);
+    free(replay.cellPushes);
+    free(replay.depthPops);
+    free(records);
+    fclose(file);
+
+    return 0;
+
+}